@@ -0,0 +1,51 @@
+#version 330 core
+// Vertex shader for the Faces mesh format: no vertex attributes, four vertices per face
+// drawn through the shared quad index buffer, so gl_VertexID is face * 4 + corner.
+// Each face is one word, see packChunkFace: x, y, z at 6 bits each, face (bits 18-20) and tile (21-31)
+uniform usamplerBuffer faces;
+
+// Position on the face in tiles
+out vec2 TileUV;
+// Bottom-left texel of the face's tile on the atlas
+flat out vec2 TileOrigin;
+// Ambient occlusion and light, always 1 since faces carry neither
+out float Occlusion;
+out float Light;
+
+uniform float atlasHeight;
+uniform float tileSize;
+uniform int tilesPerRow;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Corners of each face as offsets from the block's minimum corner, counter-clockwise seen from outside,
+// matching FACE_CORNERS in ChunkMesher.cpp. Indexed by face * 4 + corner.
+const vec3 FACE_CORNERS[24] = vec3[24](
+    vec3(1, 0, 1), vec3(1, 0, 0), vec3(1, 1, 0), vec3(1, 1, 1), // PosX
+    vec3(0, 0, 0), vec3(0, 0, 1), vec3(0, 1, 1), vec3(0, 1, 0), // NegX
+    vec3(0, 1, 1), vec3(1, 1, 1), vec3(1, 1, 0), vec3(0, 1, 0), // PosY
+    vec3(0, 0, 0), vec3(1, 0, 0), vec3(1, 0, 1), vec3(0, 0, 1), // NegY
+    vec3(0, 0, 1), vec3(1, 0, 1), vec3(1, 1, 1), vec3(0, 1, 1), // PosZ
+    vec3(1, 0, 0), vec3(0, 0, 0), vec3(0, 1, 0), vec3(1, 1, 0)  // NegZ
+);
+
+const vec2 CORNER_UVS[4] = vec2[4](vec2(0, 0), vec2(1, 0), vec2(1, 1), vec2(0, 1));
+
+void main()
+{
+    uint word = texelFetch(faces, gl_VertexID >> 2).r;
+    int corner = gl_VertexID & 3;
+    int face = int((word >> 18) & 7u);
+
+    vec3 block = vec3(word & 63u, (word >> 6) & 63u, (word >> 12) & 63u);
+    gl_Position = projection * view * model * vec4(block + FACE_CORNERS[face * 4 + corner], 1.0);
+    TileUV = CORNER_UVS[corner];
+
+    // Tiles are counted left to right from the top-left tile of the atlas
+    int tile = int(word >> 21);
+    int columns = max(tilesPerRow, 1);
+    TileOrigin = vec2(float(tile % columns) * tileSize, atlasHeight - tileSize - float(tile / columns) * tileSize);
+    Occlusion = 1.0;
+    Light = 1.0;
+}
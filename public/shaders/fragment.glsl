@@ -1,15 +1,31 @@
 #version 330 core
 
 // Input
-in vec2 TexCoord;
+in vec2 TileUV;
+flat in vec2 TileOrigin;
+in float Occlusion;
+in float Light;
 
 // Output
 out vec4 FragColor;
 
 // Bindings
 uniform sampler2D textureAtlas;
+uniform float tileSize;
+
+// Brightness of a fully occluded corner
+const float OCCLUSION_FLOOR = 0.4;
+// Brightness of a block no light reaches, so caves stay faintly visible
+const float LIGHT_FLOOR = 0.08;
 
 void main()
 {
-	FragColor = texelFetch(textureAtlas, ivec2(TexCoord), 0);
-}
\ No newline at end of file
+	// Repeat the tile once per block across quads that span several blocks
+	vec2 texel = TileOrigin + floor(fract(TileUV) * tileSize);
+	vec4 color = texelFetch(textureAtlas, ivec2(texel), 0);
+	// Baked per-vertex occlusion, interpolated across the face
+	float occlusion = mix(OCCLUSION_FLOOR, 1.0, Occlusion);
+	// Baked smooth light, squared so each level lost from the source dims more than the last
+	float light = mix(LIGHT_FLOOR, 1.0, Light * Light);
+	FragColor = vec4(color.rgb * occlusion * light, color.a);
+}
@@ -0,0 +1,41 @@
+#version 330 core
+
+// Input
+in vec3 WorldPosition;
+in vec3 Normal;
+flat in vec2 TileOrigin;
+in float Light;
+
+// Output
+out vec4 FragColor;
+
+// Bindings
+uniform sampler2D textureAtlas;
+uniform float tileSize;
+
+// Brightness of a block no light reaches, matching the block shader
+const float LIGHT_FLOOR = 0.08;
+// Direction towards the sun, and the brightness of surfaces facing away from it
+const vec3 SUN_DIRECTION = vec3(0.3, 0.9, 0.3);
+const float SHADOW_FLOOR = 0.55;
+
+void main()
+{
+	// Project the tile along the normal's strongest axis, one tile per block
+	vec3 normal = normalize(Normal);
+	vec3 weight = abs(normal);
+	vec2 uv;
+	if (weight.y >= weight.x && weight.y >= weight.z)
+		uv = WorldPosition.xz;
+	else if (weight.x >= weight.z)
+		uv = WorldPosition.zy;
+	else
+		uv = WorldPosition.xy;
+
+	vec2 texel = TileOrigin + floor(fract(uv) * tileSize);
+	vec4 color = texelFetch(textureAtlas, ivec2(texel), 0);
+	// Smooth surfaces have no block faces to shade by, so light them by their angle to the sun
+	float sun = mix(SHADOW_FLOOR, 1.0, max(dot(normal, normalize(SUN_DIRECTION)), 0.0));
+	float light = mix(LIGHT_FLOOR, 1.0, Light * Light);
+	FragColor = vec4(color.rgb * sun * light, color.a);
+}
@@ -0,0 +1,45 @@
+#version 330 core
+// Vertex shader for the SurfaceNets mesh format, see SurfaceVertex
+layout (location = 0) in vec3 aPosition;
+// Tile (bits 0-11), light (12-15) and the octahedral normal (16-23 and 24-31)
+layout (location = 1) in uint aAttributes;
+
+// World position, which the fragment shader projects onto the atlas tile
+out vec3 WorldPosition;
+out vec3 Normal;
+// Bottom-left texel of the tile on the atlas, taken from the triangle's last vertex
+flat out vec2 TileOrigin;
+// Light level in [0, 1]
+out float Light;
+
+uniform float atlasHeight;
+uniform float tileSize;
+uniform int tilesPerRow;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Unfolds a normal packed onto the octahedron |x| + |y| + |z| = 1
+vec3 decodeNormal(uint packed)
+{
+    vec2 folded = vec2(packed & 255u, (packed >> 8) & 255u) / 255.0 * 2.0 - 1.0;
+    vec3 normal = vec3(folded, 1.0 - abs(folded.x) - abs(folded.y));
+    float below = max(-normal.z, 0.0);
+    normal.xy += vec2(normal.x >= 0.0 ? -below : below, normal.y >= 0.0 ? -below : below);
+    return normalize(normal);
+}
+
+void main()
+{
+    vec4 world = model * vec4(aPosition, 1.0);
+    gl_Position = projection * view * world;
+    WorldPosition = world.xyz;
+    Normal = decodeNormal(aAttributes >> 16);
+
+    // Tiles are counted left to right from the top-left tile of the atlas
+    int tile = int(aAttributes & 0xFFFu);
+    int columns = max(tilesPerRow, 1);
+    TileOrigin = vec2(float(tile % columns) * tileSize, atlasHeight - tileSize - float(tile / columns) * tileSize);
+
+    Light = float((aAttributes >> 12) & 15u) / 15.0;
+}
@@ -1,21 +1,36 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in vec2 aTexOffset;
+// Packed chunk vertex, see ChunkVertex: x, y, z, u, v at 6 bits each
+layout (location = 0) in uint aPosition;
+// Tile (bits 0-15), face (16-18), ambient occlusion (19-20) and light (21-24)
+layout (location = 1) in uint aAttributes;
 
-out vec2 TexCoord;
+// Position on the face in tiles, beyond 1 on merged quads
+out vec2 TileUV;
+// Bottom-left texel of the face's tile on the atlas
+flat out vec2 TileOrigin;
+// Ambient occlusion in [0, 1], 1 when unoccluded
+out float Occlusion;
+// Light level in [0, 1]
+out float Light;
 
 uniform float atlasHeight;
 uniform float tileSize;
+uniform int tilesPerRow;
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    TexCoord = ivec2(
-        (aTexCoord.x * 16 + aTexOffset.x), 
-        (aTexCoord.y * 16 + aTexOffset.y) + (atlasHeight - tileSize)
-    );
-}
\ No newline at end of file
+    vec3 position = vec3(aPosition & 63u, (aPosition >> 6) & 63u, (aPosition >> 12) & 63u);
+    gl_Position = projection * view * model * vec4(position, 1.0);
+    TileUV = vec2((aPosition >> 18) & 63u, (aPosition >> 24) & 63u);
+
+    // Tiles are counted left to right from the top-left tile of the atlas
+    int tile = int(aAttributes & 0xFFFFu);
+    int columns = max(tilesPerRow, 1);
+    TileOrigin = vec2(float(tile % columns) * tileSize, atlasHeight - tileSize - float(tile / columns) * tileSize);
+
+    Occlusion = float((aAttributes >> 19) & 3u) / 3.0;
+    Light = float((aAttributes >> 21) & 15u) / 15.0;
+}
@@ -0,0 +1,14 @@
+#include <iostream>
+
+#include "Benchmarks.h"
+
+
+void runBenchmarks()
+{
+    std::cout << "Running benchmarks" << std::endl;
+    runChunkMapBenchmark();
+    runStorageBenchmark();
+    runLayoutBenchmark();
+    runFaceClassifierBenchmark();
+    runMesherBenchmark();
+}
@@ -0,0 +1,44 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <chrono>
+
+/*
+ * Microbenchmarks for the engine's data structures. They are only run when
+ * the engine is built with VOXEL_BENCHMARKS defined, in place of the window.
+ */
+
+// Times a block of code in milliseconds.
+class BenchmarkTimer
+{
+public:
+    BenchmarkTimer() : start(std::chrono::steady_clock::now()) {}
+
+    double elapsedMs() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Compares ChunkMap against std::unordered_map for insert, hit, miss and erase workloads.
+void runChunkMapBenchmark();
+
+// Compares build time, random access and memory of the world storage backends on the same terrain.
+void runStorageBenchmark();
+
+// Runs face culling, light propagation and raycasts over a chunk array stored in linear and Morton order.
+void runLayoutBenchmark();
+
+// Meshes generated terrain with each meshing mode.
+void runMesherBenchmark();
+
+// Times each supported face classifier path and checks it matches the scalar path bit for bit.
+void runFaceClassifierBenchmark();
+
+// Runs every benchmark and prints the results to stdout.
+void runBenchmarks();
+
+#endif
@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../World/ChunkMap/ChunkMap.h"
+
+
+// Chunks loaded around a player: a 64 x 16 x 64 box.
+static std::vector<ChunkCoord> loadedCoords()
+{
+    std::vector<ChunkCoord> coords;
+    for (int y = -8; y < 8; y++)
+        for (int z = -32; z < 32; z++)
+            for (int x = -32; x < 32; x++)
+                coords.push_back(ChunkCoord{ x, y, z });
+    return coords;
+}
+
+// Random lookups clustered inside the loaded box, plus a share that miss it.
+static std::vector<ChunkCoord> queryCoords(std::size_t count, bool hits)
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> xz(-32, 31);
+    std::uniform_int_distribution<int> y(-8, 7);
+    std::vector<ChunkCoord> coords(count);
+    for (ChunkCoord& coord : coords)
+        coord = ChunkCoord{ xz(rng), hits ? y(rng) : y(rng) + 100, xz(rng) };
+    return coords;
+}
+
+static void printResult(const char* name, double chunkMapMs, double unorderedMs)
+{
+    std::cout << "  " << name << ": ChunkMap " << chunkMapMs << " ms, std::unordered_map " << unorderedMs
+        << " ms (" << unorderedMs / chunkMapMs << "x)" << std::endl;
+}
+
+void runChunkMapBenchmark()
+{
+    const std::vector<ChunkCoord> coords = loadedCoords();
+    const std::vector<ChunkCoord> hits = queryCoords(10000000, true);
+    const std::vector<ChunkCoord> misses = queryCoords(10000000, false);
+
+    std::cout << "ChunkMap vs std::unordered_map (" << coords.size() << " chunks, "
+        << hits.size() << " lookups)" << std::endl;
+
+    ChunkMap<std::uintptr_t> chunkMap;
+    std::unordered_map<std::uint64_t, std::uintptr_t> unorderedMap;
+    std::uintptr_t checksum = 0;
+
+    // Insert
+    BenchmarkTimer chunkMapInsert;
+    for (std::size_t i = 0; i < coords.size(); i++)
+        chunkMap[coords[i]] = i + 1;
+    double chunkMapMs = chunkMapInsert.elapsedMs();
+
+    BenchmarkTimer unorderedInsert;
+    for (std::size_t i = 0; i < coords.size(); i++)
+        unorderedMap[ChunkMap<std::uintptr_t>::packCoord(coords[i])] = i + 1;
+    printResult("insert", chunkMapMs, unorderedInsert.elapsedMs());
+
+    // Lookups that hit
+    BenchmarkTimer chunkMapHit;
+    for (const ChunkCoord& coord : hits)
+        checksum += *chunkMap.find(coord);
+    chunkMapMs = chunkMapHit.elapsedMs();
+
+    BenchmarkTimer unorderedHit;
+    for (const ChunkCoord& coord : hits)
+        checksum -= unorderedMap.find(ChunkMap<std::uintptr_t>::packCoord(coord))->second;
+    printResult("lookup hit", chunkMapMs, unorderedHit.elapsedMs());
+
+    // Lookups that miss
+    BenchmarkTimer chunkMapMiss;
+    for (const ChunkCoord& coord : misses)
+        checksum += chunkMap.find(coord) != nullptr;
+    chunkMapMs = chunkMapMiss.elapsedMs();
+
+    BenchmarkTimer unorderedMiss;
+    for (const ChunkCoord& coord : misses)
+        checksum += unorderedMap.count(ChunkMap<std::uintptr_t>::packCoord(coord));
+    printResult("lookup miss", chunkMapMs, unorderedMiss.elapsedMs());
+
+    // Erase
+    BenchmarkTimer chunkMapErase;
+    for (const ChunkCoord& coord : coords)
+        chunkMap.erase(coord);
+    chunkMapMs = chunkMapErase.elapsedMs();
+
+    BenchmarkTimer unorderedErase;
+    for (const ChunkCoord& coord : coords)
+        unorderedMap.erase(ChunkMap<std::uintptr_t>::packCoord(coord));
+    printResult("erase", chunkMapMs, unorderedErase.elapsedMs());
+
+    // Printing the checksum keeps the lookups from being optimized away; it is 0 when both maps agree.
+    std::cout << "  checksum " << checksum << std::endl;
+}
@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../World/BlockRegistry/BlockRegistry.h"
+#include "../World/FaceClassifier/FaceClassifier.h"
+#include "../World/PaddedChunk/PaddedChunk.h"
+#include "../World/TerrainGenerator/TerrainGenerator.h"
+#include "../World/World/World.h"
+
+
+// Fills padded block arrays with short runs of random registered blocks, air included, at several densities of air.
+static void addRandomChunks(std::vector<std::vector<BlockID>>& chunks)
+{
+    const int blockCount = (int)BlockRegistry::instance().getBlockCount();
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> block(0, blockCount - 1);
+    std::uniform_int_distribution<int> run(1, 4);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+    for (double air : { 0.0, 0.1, 0.5, 0.9, 1.0 })
+    {
+        std::vector<BlockID> blocks(PADDED_VOLUME);
+        for (int i = 0; i < PADDED_VOLUME;)
+        {
+            const BlockID id = chance(rng) < air ? BLOCK_AIR : (BlockID)block(rng);
+            for (int n = run(rng); n > 0 && i < PADDED_VOLUME; n--)
+                blocks[i++] = id;
+        }
+        chunks.push_back(std::move(blocks));
+    }
+}
+
+// Copies padded chunks around the surface of generated terrain.
+static void addTerrainChunks(std::vector<std::vector<BlockID>>& chunks)
+{
+    World world;
+    TerrainGenerator generator;
+    for (int z = -1; z <= 2; z++)
+        for (int y = -2; y <= 2; y++)
+            for (int x = -1; x <= 2; x++)
+                generator.generate(world, ChunkCoord{ x, y, z });
+
+    PaddedChunk padded;
+    for (int z = 0; z < 2; z++)
+        for (int x = 0; x < 2; x++)
+        {
+            const int surface = World::toChunkCoord(0, generator.getSurfaceHeight(x * CHUNK_SIZE, z * CHUNK_SIZE), 0).y;
+            for (int y = surface - 1; y <= surface + 1; y++)
+            {
+                padded.fill(world.snapshotNeighborhood(ChunkCoord{ x, y, z }));
+                chunks.emplace_back(padded.data(), padded.data() + PADDED_VOLUME);
+            }
+        }
+}
+
+void runFaceClassifierBenchmark()
+{
+    const BlockRegistry& registry = BlockRegistry::instance();
+    const FaceClassifier classifier(registry.getOpacityTable(), registry.getBlockCount());
+    std::cout << "Face classifier (" << CHUNK_SIZE << "^3 chunks, default path "
+              << FaceClassifier::getPathName(classifier.getPath()) << ")" << std::endl;
+
+    std::vector<std::vector<BlockID>> chunks;
+    addRandomChunks(chunks);
+    addTerrainChunks(chunks);
+
+    // The scalar path is the reference; every SIMD path must reproduce it bit for bit.
+    std::vector<std::uint8_t> expected(chunks.size() * CHUNK_VOLUME);
+    for (std::size_t i = 0; i < chunks.size(); i++)
+        classifier.classify(chunks[i].data(), expected.data() + i * CHUNK_VOLUME, SimdPath::Scalar);
+
+    const int rounds = 50;
+    std::vector<std::uint8_t> faces(CHUNK_VOLUME);
+    for (SimdPath path : { SimdPath::Scalar, SimdPath::AVX2, SimdPath::NEON })
+    {
+        if (!FaceClassifier::isSupported(path))
+            continue;
+
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < chunks.size(); i++)
+        {
+            classifier.classify(chunks[i].data(), faces.data(), path);
+            if (std::memcmp(faces.data(), expected.data() + i * CHUNK_VOLUME, CHUNK_VOLUME) != 0)
+                mismatches++;
+        }
+
+        BenchmarkTimer timer;
+        for (int round = 0; round < rounds; round++)
+            for (const std::vector<BlockID>& blocks : chunks)
+                classifier.classify(blocks.data(), faces.data(), path);
+        const double ms = timer.elapsedMs();
+
+        std::cout << "  " << FaceClassifier::getPathName(path) << ": " << ms * 1000.0 / (rounds * chunks.size()) << " us/chunk, "
+                  << (mismatches == 0 ? "matches scalar" : "MISMATCH") << " (" << chunks.size() - mismatches << "/"
+                  << chunks.size() << " chunks)" << std::endl;
+    }
+}
@@ -0,0 +1,188 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../World/Block/Block.h"
+#include "../World/BlockLayout/BlockLayout.h"
+#include "../World/Chunk/Chunk.h"
+
+
+// A chunk-sized block array indexed with the given layout, plus a light level per block.
+template <typename Layout>
+struct LayoutChunk
+{
+    std::vector<BlockID> blocks = std::vector<BlockID>(CHUNK_VOLUME, BLOCK_AIR);
+    std::vector<std::uint8_t> light = std::vector<std::uint8_t>(CHUNK_VOLUME, 0);
+
+    static bool inside(int x, int y, int z)
+    {
+        return x >= 0 && y >= 0 && z >= 0 && x < CHUNK_SIZE && y < CHUNK_SIZE && z < CHUNK_SIZE;
+    }
+
+    BlockID get(int x, int y, int z) const
+    {
+        return inside(x, y, z) ? blocks[Layout::index(x, y, z)] : BLOCK_AIR;
+    }
+};
+
+// Fills the chunk with hilly ground riddled with small caves.
+template <typename Layout>
+static void generate(LayoutChunk<Layout>& chunk)
+{
+    std::mt19937 rng(7);
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+            for (int x = 0; x < CHUNK_SIZE; x++)
+            {
+                const int height = CHUNK_SIZE / 2 + (int)(4.0 * std::sin(x * 0.3) + 4.0 * std::cos(z * 0.25));
+                if (y < height && rng() % 5 != 0)
+                    chunk.blocks[Layout::index(x, y, z)] = y == height - 1 ? BLOCK_GRASS : BLOCK_DIRT;
+            }
+}
+
+static const int OFFSETS[6][3] = { {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1} };
+
+// Counts the faces of solid blocks that touch air.
+template <typename Layout>
+static std::uint64_t cullFaces(const LayoutChunk<Layout>& chunk)
+{
+    std::uint64_t faces = 0;
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+            for (int x = 0; x < CHUNK_SIZE; x++)
+            {
+                if (chunk.blocks[Layout::index(x, y, z)] == BLOCK_AIR)
+                    continue;
+                for (const int* o : OFFSETS)
+                    faces += chunk.get(x + o[0], y + o[1], z + o[2]) == BLOCK_AIR;
+            }
+    return faces;
+}
+
+// Breadth-first light flood fill from the top layer of air, losing one level per step.
+template <typename Layout>
+static std::uint64_t propagateLight(LayoutChunk<Layout>& chunk)
+{
+    std::fill(chunk.light.begin(), chunk.light.end(), 0);
+    std::vector<int> queue;
+    queue.reserve(CHUNK_VOLUME * 3);
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int x = 0; x < CHUNK_SIZE; x++)
+        {
+            const int i = Layout::index(x, CHUNK_SIZE - 1, z);
+            if (chunk.blocks[i] == BLOCK_AIR)
+            {
+                chunk.light[i] = 15;
+                queue.insert(queue.end(), { x, CHUNK_SIZE - 1, z });
+            }
+        }
+
+    for (std::size_t head = 0; head < queue.size(); head += 3)
+    {
+        const int x = queue[head], y = queue[head + 1], z = queue[head + 2];
+        const std::uint8_t level = chunk.light[Layout::index(x, y, z)];
+        if (level <= 1)
+            continue;
+        for (const int* o : OFFSETS)
+        {
+            const int nx = x + o[0], ny = y + o[1], nz = z + o[2];
+            if (!LayoutChunk<Layout>::inside(nx, ny, nz))
+                continue;
+            const int n = Layout::index(nx, ny, nz);
+            if (chunk.blocks[n] == BLOCK_AIR && chunk.light[n] < level - 1)
+            {
+                chunk.light[n] = level - 1;
+                queue.insert(queue.end(), { nx, ny, nz });
+            }
+        }
+    }
+
+    std::uint64_t total = 0;
+    for (std::uint8_t level : chunk.light)
+        total += level;
+    return total;
+}
+
+// Casts voxel-stepping (DDA) rays through the chunk and sums the distance travelled to the first solid block.
+template <typename Layout>
+static std::uint64_t castRays(const LayoutChunk<Layout>& chunk, const std::vector<float>& rays)
+{
+    std::uint64_t steps = 0;
+    for (std::size_t r = 0; r < rays.size(); r += 6)
+    {
+        int cell[3], step[3];
+        float tMax[3], tDelta[3];
+        for (int a = 0; a < 3; a++)
+        {
+            const float origin = rays[r + a], dir = rays[r + 3 + a];
+            cell[a] = (int)std::floor(origin);
+            step[a] = dir > 0.0f ? 1 : -1;
+            tDelta[a] = dir != 0.0f ? std::abs(1.0f / dir) : 1e30f;
+            tMax[a] = dir != 0.0f ? ((dir > 0.0f ? cell[a] + 1 : cell[a]) - origin) / dir : 1e30f;
+        }
+
+        while (LayoutChunk<Layout>::inside(cell[0], cell[1], cell[2])
+            && chunk.blocks[Layout::index(cell[0], cell[1], cell[2])] == BLOCK_AIR)
+        {
+            const int a = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+            cell[a] += step[a];
+            tMax[a] += tDelta[a];
+            steps++;
+        }
+    }
+    return steps;
+}
+
+template <typename Layout>
+static void runLayout(const char* name, const std::vector<float>& rays)
+{
+    LayoutChunk<Layout> chunk;
+    generate(chunk);
+    std::uint64_t checksum = 0;
+
+    BenchmarkTimer culling;
+    for (int i = 0; i < 200; i++)
+        checksum += cullFaces(chunk);
+    const double cullingMs = culling.elapsedMs();
+
+    BenchmarkTimer lighting;
+    for (int i = 0; i < 50; i++)
+        checksum += propagateLight(chunk);
+    const double lightingMs = lighting.elapsedMs();
+
+    BenchmarkTimer raycasts;
+    checksum += castRays(chunk, rays);
+    const double raycastMs = raycasts.elapsedMs();
+
+    std::cout << "  " << name << ": face culling x200 " << cullingMs << " ms, light propagation x50 "
+        << lightingMs << " ms, " << rays.size() / 6 << " raycasts " << raycastMs << " ms (checksum "
+        << checksum << ")" << std::endl;
+}
+
+// Runs the Morton layout when the chunk size allows one, since it only exists for power-of-two sizes.
+template <int Size>
+static void runMortonLayout(const std::vector<float>& rays)
+{
+    if constexpr ((Size & (Size - 1)) == 0)
+        runLayout<MortonLayout<Size>>("morton", rays);
+    else
+        std::cout << "  morton: skipped, " << Size << " is not a power of two" << std::endl;
+}
+
+void runLayoutBenchmark()
+{
+    // Rays start anywhere in the chunk and point in random directions.
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> position(0.0f, (float)CHUNK_SIZE);
+    std::normal_distribution<float> direction(0.0f, 1.0f);
+    std::vector<float> rays;
+    for (int i = 0; i < 1000000; i++)
+        rays.insert(rays.end(), { position(rng), position(rng), position(rng), direction(rng), direction(rng), direction(rng) });
+
+    std::cout << "Block index layouts (" << CHUNK_SIZE << "^3 chunk)" << std::endl;
+    runLayout<LinearLayout<CHUNK_SIZE>>("linear", rays);
+    runMortonLayout<CHUNK_SIZE>(rays);
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../World/ChunkMesher/ChunkMesher.h"
+#include "../World/PaddedChunk/PaddedChunk.h"
+#include "../World/SurfaceNetsMesher/SurfaceNetsMesher.h"
+#include "../World/TerrainGenerator/TerrainGenerator.h"
+#include "../World/World/World.h"
+
+
+// Meshes the same padded chunks with the given mode and prints the time per chunk and the vertex count.
+static void timeMesher(const char* name, MeshingMode mode, const std::vector<PaddedChunk>& chunks, int rounds)
+{
+    const ChunkMesher mesher(mode);
+    std::vector<ChunkVertex> vertices;
+    std::size_t vertexCount = 0;
+
+    BenchmarkTimer timer;
+    for (int round = 0; round < rounds; round++)
+    {
+        for (const PaddedChunk& chunk : chunks)
+        {
+            mesher.mesh(chunk, vertices);
+            vertexCount += vertices.size();
+        }
+    }
+    const double ms = timer.elapsedMs();
+
+    std::cout << "  " << name << ": " << ms * 1000.0 / (rounds * chunks.size()) << " us/chunk, "
+              << vertexCount / rounds << " vertices" << std::endl;
+}
+
+// Meshes the same padded chunks with surface nets and prints the time per chunk and the vertex and triangle counts.
+static void timeSurfaceNets(const std::vector<PaddedChunk>& chunks, int rounds)
+{
+    const SurfaceNetsMesher mesher;
+    std::vector<SurfaceVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::size_t vertexCount = 0;
+    std::size_t indexCount = 0;
+
+    BenchmarkTimer timer;
+    for (int round = 0; round < rounds; round++)
+    {
+        for (const PaddedChunk& chunk : chunks)
+        {
+            mesher.mesh(chunk, vertices, indices);
+            vertexCount += vertices.size();
+            indexCount += indices.size();
+        }
+    }
+    const double ms = timer.elapsedMs();
+
+    std::cout << "  surface nets: " << ms * 1000.0 / (rounds * chunks.size()) << " us/chunk, "
+              << vertexCount / rounds << " vertices, " << indexCount / rounds / 3 << " triangles" << std::endl;
+}
+
+void runMesherBenchmark()
+{
+    std::cout << "Mesher (" << CHUNK_SIZE << "^3 chunks on generated terrain)" << std::endl;
+
+    // A 4x4 area of chunk columns, three chunks tall around the surface.
+    World world;
+    TerrainGenerator generator;
+    for (int z = -1; z <= 4; z++)
+        for (int y = -2; y <= 2; y++)
+            for (int x = -1; x <= 4; x++)
+                generator.generate(world, ChunkCoord{ x, y, z });
+
+    std::vector<PaddedChunk> chunks;
+    for (int z = 0; z < 4; z++)
+        for (int x = 0; x < 4; x++)
+        {
+            const int surface = World::toChunkCoord(0, generator.getSurfaceHeight(x * CHUNK_SIZE, z * CHUNK_SIZE), 0).y;
+            for (int y = surface - 1; y <= surface + 1; y++)
+            {
+                chunks.emplace_back();
+                chunks.back().fill(world.snapshotNeighborhood(ChunkCoord{ x, y, z }));
+            }
+        }
+
+    timeMesher("culled", MeshingMode::Culled, chunks, 20);
+    timeMesher("greedy", MeshingMode::Greedy, chunks, 20);
+    timeMesher("binary greedy", MeshingMode::BinaryGreedy, chunks, 20);
+    timeSurfaceNets(chunks, 20);
+}
@@ -0,0 +1,76 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../World/ChunkPools/ChunkPools.h"
+#include "../World/VoxelStorage/VoxelStorage.h"
+
+
+// Rolling terrain 512 blocks wide with a surface between y = 16 and y = 48, and empty sky up to y = 256.
+static const int TERRAIN_WIDTH = 512;
+static const int TERRAIN_HEIGHT = 256;
+
+static int terrainHeight(int x, int z)
+{
+    return 32 + (int)(10.0 * std::sin(x * 0.05) + 6.0 * std::cos(z * 0.07));
+}
+
+// Builds the terrain in one backend and times random reads and writes, optionally printing the chunk
+// memory pools at the end while the storage still holds its blocks.
+static void runStorage(const char* name, WorldStorageType type, bool printPools = false)
+{
+    std::unique_ptr<VoxelStorage> storage = createVoxelStorage(type);
+    const int half = TERRAIN_WIDTH / 2;
+
+    BenchmarkTimer build;
+    for (int z = -half; z < half; z++)
+        for (int x = -half; x < half; x++)
+        {
+            const int height = terrainHeight(x, z);
+            for (int y = 0; y < height; y++)
+                storage->setBlock(x, y, z, y == height - 1 ? BLOCK_GRASS : BLOCK_DIRT);
+        }
+    const double buildMs = build.elapsedMs();
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> xz(-half, half - 1);
+    std::uniform_int_distribution<int> y(0, TERRAIN_HEIGHT - 1);
+    std::vector<int> positions(3 * 4000000);
+    for (std::size_t i = 0; i < positions.size(); i += 3)
+    {
+        positions[i] = xz(rng);
+        positions[i + 1] = y(rng);
+        positions[i + 2] = xz(rng);
+    }
+
+    std::uint64_t checksum = 0;
+    BenchmarkTimer reads;
+    for (std::size_t i = 0; i < positions.size(); i += 3)
+        checksum += storage->getBlock(positions[i], positions[i + 1], positions[i + 2]);
+    const double readMs = reads.elapsedMs();
+
+    BenchmarkTimer writes;
+    for (std::size_t i = 0; i < 3 * 200000; i += 3)
+        storage->setBlock(positions[i], positions[i + 1], positions[i + 2], BLOCK_AIR);
+    const double writeMs = writes.elapsedMs();
+
+    std::cout << "  " << name << ": build " << buildMs << " ms, " << positions.size() / 3 << " random reads "
+        << readMs << " ms, 200000 random writes " << writeMs << " ms, memory "
+        << storage->memoryUsage() / 1024 << " KB (checksum " << checksum << ")" << std::endl;
+
+    if (printPools)
+        ChunkPools::printStats();
+}
+
+void runStorageBenchmark()
+{
+    std::cout << "World storage backends (" << TERRAIN_WIDTH << " x " << TERRAIN_HEIGHT << " x " << TERRAIN_WIDTH
+        << " terrain)" << std::endl;
+    runStorage("chunks", WorldStorageType::Chunks, true);
+    runStorage("octree", WorldStorageType::Octree);
+    runStorage("brickmap", WorldStorageType::Brickmap);
+}
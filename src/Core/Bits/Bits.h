@@ -0,0 +1,53 @@
+#ifndef BITS_H
+#define BITS_H
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+ * Bit manipulation helpers for the bitmask kernels. The bit scans map to a
+ * single instruction (tzcnt/bsf, rbit+clz) on every supported compiler.
+ */
+
+// Returns the index of the lowest set bit; the value must not be zero.
+inline int countTrailingZeros(std::uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// Returns the number of consecutive set bits starting at the lowest bit.
+inline int countTrailingOnes(std::uint64_t value)
+{
+    return ~value == 0 ? 64 : countTrailingZeros(~value);
+}
+
+/**
+ * Transposes a 64x64 bit matrix in place in six rounds of block swaps, so bit j
+ * of row i moves to bit i of row j.
+ *
+ * @param rows The matrix, one 64-bit row per element.
+ */
+inline void transpose64(std::uint64_t rows[64])
+{
+    std::uint64_t mask = 0x00000000FFFFFFFFull;
+    for (int width = 32; width != 0; width >>= 1, mask ^= mask << width)
+    {
+        for (int k = 0; k < 64; k = ((k | width) + 1) & ~width)
+        {
+            const std::uint64_t t = ((rows[k] >> width) ^ rows[k | width]) & mask;
+            rows[k] ^= t << width;
+            rows[k | width] ^= t;
+        }
+    }
+}
+
+#endif
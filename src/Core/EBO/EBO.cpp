@@ -0,0 +1,23 @@
+#include "EBO.h"
+
+EBO::EBO(const GLuint* indices, GLsizeiptr size) {
+    glGenBuffers(1, &ID);
+    upload(indices, size);
+}
+
+void EBO::upload(const GLuint* indices, GLsizeiptr size) const {
+    bind();
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+}
+
+void EBO::bind() const {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+}
+
+void EBO::unbind() const {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void EBO::remove() const {
+    glDeleteBuffers(1, &ID);
+}
@@ -0,0 +1,28 @@
+#ifndef EBO_H
+#define EBO_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+class EBO {
+public:
+    // EBO ID
+    GLuint ID;
+
+    // Constructor for EBO, uploading size bytes of indices
+    EBO(const GLuint* indices, GLsizeiptr size);
+
+    // Replaces the indices, resizing the buffer to size bytes; the ID stays the same
+    void upload(const GLuint* indices, GLsizeiptr size) const;
+
+    // Binds the EBO to GL_ELEMENT_ARRAY_BUFFER, which the bound VAO records
+    void bind() const;
+
+    // Unbinds the EBO
+    void unbind() const;
+
+    // Deletes the EBO
+    void remove() const;
+};
+
+#endif
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstddef>
+
+#include "Renderer.h"
+
+ChunkMesh::ChunkMesh(const std::vector<ChunkVertex>& vertices, const EBO& quadIndices)
+    : vbo(vertices.data(), (GLsizeiptr)(vertices.size() * sizeof(ChunkVertex))),
+      vertexCount((GLsizei)vertices.size()),
+      indexCount((GLsizei)(vertices.size() / 4 * 6)),
+      bytes(vertices.size() * sizeof(ChunkVertex))
+{
+    quadIndices.bind();
+
+    // The VAO was bound by its constructor, so the attributes below are recorded in it. Both words
+    // stay integers (IPointer) so the shader can unpack their bit fields.
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, position));
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, attributes));
+    glEnableVertexAttribArray(1);
+
+    vao.unbind();
+}
+
+ChunkMesh::ChunkMesh(const std::vector<std::uint32_t>& faces, const EBO& quadIndices)
+    : vbo(faces.data(), (GLsizeiptr)(faces.size() * sizeof(std::uint32_t))),
+      vertexCount((GLsizei)(faces.size() * 4)),
+      indexCount((GLsizei)(faces.size() * 6)),
+      bytes(faces.size() * sizeof(std::uint32_t))
+{
+    // The VAO only records the index buffer; the shader derives each face and corner from gl_VertexID.
+    quadIndices.bind();
+    vao.unbind();
+
+    glGenTextures(1, &faceTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, faceTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, vbo.ID);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+ChunkMesh::ChunkMesh(const std::vector<SurfaceVertex>& vertices, const std::vector<std::uint32_t>& indices)
+    : vbo(vertices.data(), (GLsizeiptr)(vertices.size() * sizeof(SurfaceVertex))),
+      ebo(std::make_unique<EBO>(indices.data(), (GLsizeiptr)(indices.size() * sizeof(GLuint)))),
+      vertexCount((GLsizei)vertices.size()),
+      indexCount((GLsizei)indices.size()),
+      bytes(vertices.size() * sizeof(SurfaceVertex) + indices.size() * sizeof(GLuint))
+{
+    // The EBO was bound to the VAO by its constructor. The attributes word stays an integer (IPointer)
+    // so the shader can unpack its bit fields.
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SurfaceVertex), (void*)offsetof(SurfaceVertex, position));
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(SurfaceVertex), (void*)offsetof(SurfaceVertex, attributes));
+    glEnableVertexAttribArray(1);
+
+    vao.unbind();
+}
+
+ChunkMesh::~ChunkMesh()
+{
+    if (faceTexture)
+        glDeleteTextures(1, &faceTexture);
+    if (ebo)
+        ebo->remove();
+    vao.remove();
+    vbo.remove();
+}
+
+Renderer::Renderer(ChunkMeshFormat format)
+    : format(format), workers(mesher, surfaceMesher, format), quadIndices(nullptr, 0)
+{
+}
+
+Renderer::~Renderer()
+{
+    quadIndices.remove();
+}
+
+void Renderer::update(World& world)
+{
+    // Drop the meshes of unloaded chunks first, so their neighbors can be queued with the edited chunks.
+    const std::vector<ChunkCoord> unloaded = world.takeUnloadedChunks();
+    for (const ChunkCoord& coord : unloaded)
+    {
+        RenderChunk* chunk = chunks.find(coord);
+        if (chunk && !world.getChunk(coord))
+        {
+            releaseMesh(*chunk);
+            chunks.erase(coord);
+        }
+    }
+
+    // Collect each edited chunk once, along with the neighbors whose border faces it can change. Chunks
+    // that were loaded or unloaded since the last update change all of their neighbors' borders, as if
+    // every section was edited.
+    auto queueAround = [&](ChunkCoord center, std::uint64_t sections) {
+        for (int dz = -1; dz <= 1; dz++)
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    const ChunkCoord coord{ center.x + dx, center.y + dy, center.z + dz };
+                    if (!touchesNeighbor(sections, dx, dy, dz) || !world.getChunk(coord))
+                        continue;
+
+                    std::uint8_t& seen = queued[coord];
+                    if (!seen)
+                        toMesh.push_back(coord);
+                    seen = 1;
+                }
+    };
+    for (const DirtyChunk& dirty : world.takeDirtyChunks())
+        queueAround(dirty.coord, chunks.find(dirty.coord) ? dirty.sections : ~std::uint64_t(0));
+    for (const ChunkCoord& coord : unloaded)
+        queueAround(coord, ~std::uint64_t(0));
+    for (const ChunkCoord& coord : toMesh)
+        schedule(world, coord);
+    if (!toMesh.empty())
+    {
+        queued.clear();
+        toMesh.clear();
+    }
+
+    workers.collect(finished);
+    for (MeshResult& result : finished)
+        upload(result);
+    finished.clear();
+}
+
+void Renderer::draw(const Shader& shader) const
+{
+    if (format == ChunkMeshFormat::Faces)
+    {
+        shader.setInt("faces", FACE_TEXTURE_UNIT);
+        glActiveTexture(GL_TEXTURE0 + FACE_TEXTURE_UNIT);
+    }
+
+    chunks.forEach([&](ChunkCoord coord, const RenderChunk& chunk) {
+        if (!chunk.mesh)
+            return;
+
+        const glm::vec3 origin = glm::vec3(coord.x, coord.y, coord.z) * (float)CHUNK_SIZE;
+        shader.setMat4("model", glm::translate(glm::mat4(1.0f), origin));
+        chunk.mesh->vao.bind();
+        if (chunk.mesh->faceTexture)
+            glBindTexture(GL_TEXTURE_BUFFER, chunk.mesh->faceTexture);
+        glDrawElements(GL_TRIANGLES, chunk.mesh->indexCount, GL_UNSIGNED_INT, nullptr);
+    });
+
+    // Leave the atlas' unit active for the rest of the frame.
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Renderer::schedule(const World& world, ChunkCoord coord)
+{
+    RenderChunk& chunk = chunks[coord];
+    chunk.version = nextVersion++;
+    workers.submit(MeshJob{ coord, chunk.version, world.snapshotNeighborhood(coord) });
+}
+
+void Renderer::upload(MeshResult& result)
+{
+    RenderChunk* chunk = chunks.find(result.coord);
+    if (!chunk || chunk->version != result.version)
+        return;
+
+    releaseMesh(*chunk);
+    if (result.vertices.empty() && result.faces.empty() && result.surfaceIndices.empty())
+        return;
+
+    if (format == ChunkMeshFormat::SurfaceNets)
+    {
+        chunk->mesh = std::make_unique<ChunkMesh>(result.surfaceVertices, result.surfaceIndices);
+    }
+    else if (format == ChunkMeshFormat::Faces)
+    {
+        reserveQuads(result.faces.size());
+        chunk->mesh = std::make_unique<ChunkMesh>(result.faces, quadIndices);
+    }
+    else
+    {
+        reserveQuads(result.vertices.size() / 4);
+        chunk->mesh = std::make_unique<ChunkMesh>(result.vertices, quadIndices);
+    }
+    meshCount++;
+    vertexCount += chunk->mesh->vertexCount;
+    meshBytes += chunk->mesh->bytes;
+}
+
+void Renderer::reserveQuads(std::size_t quads)
+{
+    if (quads <= quadCapacity)
+        return;
+
+    // Grow geometrically so a run of slightly larger meshes does not rebuild the buffer each time.
+    quadCapacity = std::max(quads, quadCapacity * 2);
+    std::vector<GLuint> indices(quadCapacity * 6);
+    for (std::size_t quad = 0; quad < quadCapacity; quad++)
+    {
+        for (int i = 0; i < 6; i++)
+            indices[quad * 6 + i] = (GLuint)(quad * 4 + QUAD_INDEX_PATTERN[i]);
+    }
+
+    // With no VAO bound, binding the buffer to upload does not change any mesh's index buffer.
+    glBindVertexArray(0);
+    quadIndices.upload(indices.data(), (GLsizeiptr)(indices.size() * sizeof(GLuint)));
+}
+
+void Renderer::releaseMesh(RenderChunk& chunk)
+{
+    if (!chunk.mesh)
+        return;
+
+    meshCount--;
+    vertexCount -= chunk.mesh->vertexCount;
+    meshBytes -= chunk.mesh->bytes;
+    chunk.mesh.reset();
+}
+
+bool Renderer::touchesNeighbor(std::uint64_t sections, int dx, int dy, int dz)
+{
+    const int offsets[3] = { dx, dy, dz };
+    for (int s = 0; s < SECTIONS_PER_CHUNK; s++)
+    {
+        if (!(sections & (std::uint64_t(1) << s)))
+            continue;
+
+        const int position[3] = { s % SECTIONS_PER_AXIS, (s / SECTIONS_PER_AXIS) % SECTIONS_PER_AXIS, s / (SECTIONS_PER_AXIS * SECTIONS_PER_AXIS) };
+        bool touches = true;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if ((offsets[axis] == -1 && position[axis] != 0) || (offsets[axis] == 1 && position[axis] != SECTIONS_PER_AXIS - 1))
+                touches = false;
+        }
+        if (touches)
+            return true;
+    }
+    return false;
+}
@@ -1,20 +1,193 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "../../Shaders/Shader.h"
+#include "../EBO/EBO.h"
+#include "../VAO/VAO.h"
+#include "../VBO/VBO.h"
+#include "../../World/ChunkMap/ChunkMap.h"
+#include "../../World/ChunkMesher/ChunkMesher.h"
+#include "../../World/MeshWorkers/MeshWorkers.h"
+#include "../../World/SurfaceNetsMesher/SurfaceNetsMesher.h"
+#include "../../World/World/World.h"
+
+// Texture unit the face vertex shader reads a chunk's faces from.
+constexpr int FACE_TEXTURE_UNIT = 1;
+
+// The GPU buffers holding one chunk's mesh.
+class ChunkMesh
+{
+public:
+    VAO vao;
+    VBO vbo;
+
+    // Buffer texture over vbo for meshes in the Faces format, 0 for meshes of vertices.
+    GLuint faceTexture = 0;
+
+    // Index buffer of a SurfaceNets mesh, whose vertices are shared between quads; null for meshes
+    // drawn with the shared quad index buffer.
+    std::unique_ptr<EBO> ebo;
+
+    // Number of vertices, four per quad unless quads share them; in the Faces format they are
+    // generated by the shader.
+    GLsizei vertexCount;
+
+    // Number of indices to draw, six per quad.
+    GLsizei indexCount;
+
+    // Size of the buffer in bytes.
+    std::size_t bytes;
+
+    /**
+     * Constructor uploads a mesh and sets up its vertex attributes.
+     *
+     * @param vertices The mesh's vertices, four per quad.
+     * @param quadIndices The shared quad index buffer, holding at least as many quads as the mesh.
+     */
+    ChunkMesh(const std::vector<ChunkVertex>& vertices, const EBO& quadIndices);
+
+    /**
+     * Constructor uploads a mesh in the Faces format and exposes it as a buffer texture.
+     * It has no vertex attributes; the shader pulls each face by gl_VertexID.
+     *
+     * @param faces The mesh's packed faces.
+     * @param quadIndices The shared quad index buffer, holding at least as many quads as there are faces.
+     */
+    ChunkMesh(const std::vector<std::uint32_t>& faces, const EBO& quadIndices);
+
+    /**
+     * Constructor uploads a SurfaceNets mesh with its own index buffer and sets up its vertex attributes.
+     *
+     * @param vertices The mesh's vertices.
+     * @param indices Three indices into vertices per triangle.
+     */
+    ChunkMesh(const std::vector<SurfaceVertex>& vertices, const std::vector<std::uint32_t>& indices);
+
+    // Destructor deletes the buffers.
+    ~ChunkMesh();
+
+    ChunkMesh(const ChunkMesh&) = delete;
+    ChunkMesh& operator=(const ChunkMesh&) = delete;
+};
+
+/*
+ * Draws the world's chunks. Chunks edited since the last frame are meshed on
+ * worker threads from snapshots and uploaded once their mesh comes back, so
+ * editing and streaming never wait on meshing.
+ */
 class Renderer
 {
 public:
-    Renderer()
-    {
+    /**
+     * Constructor starts the mesh workers.
+     *
+     * @param format How meshes are stored on the GPU; Faces needs the face vertex shader and
+     *               SurfaceNets the surface shaders.
+     */
+    explicit Renderer(ChunkMeshFormat format = ChunkMeshFormat::Vertices);
+
+    // Destructor deletes the shared quad index buffer.
+    ~Renderer();
+
+    /**
+     * Queues meshes for edited chunks and their affected neighbors, uploads finished
+     * meshes, and drops the meshes of unloaded chunks. The loaded neighbors of chunks that were
+     * loaded or unloaded are meshed again.
+     *
+     * @param world The world being drawn.
+     */
+    void update(World& world);
 
-    }
+    /**
+     * Draws every chunk mesh. The shader must be in use with its view and projection set.
+     *
+     * @param shader The block shader, or the face or surface shader in those formats; its
+     *               model matrix is set per chunk.
+     */
+    void draw(const Shader& shader) const;
 
-    void renderCube()
+    // Returns the number of chunks with a non-empty mesh.
+    std::size_t getMeshCount() const { return meshCount; }
+
+    // Returns the number of vertices drawn across all uploaded meshes.
+    std::size_t getVertexCount() const { return vertexCount; }
+
+    // Returns the GPU memory used by all uploaded meshes, in bytes.
+    std::size_t getMeshBytes() const { return meshBytes; }
+
+private:
+    struct RenderChunk
     {
+        // Null while the chunk has no visible faces or its first mesh is still being built.
+        std::unique_ptr<ChunkMesh> mesh;
+
+        // Version of the latest job submitted for the chunk; older results are discarded.
+        std::uint32_t version = 0;
+    };
+
+    ChunkMeshFormat format;
+    ChunkMesher mesher;
+    SurfaceNetsMesher surfaceMesher;
+    MeshWorkers workers;
+    ChunkMap<RenderChunk> chunks;
+    std::vector<MeshResult> finished;
+
+    // Chunks queued for meshing during an update, kept between updates to reuse their storage.
+    ChunkMap<std::uint8_t> queued;
+    std::vector<ChunkCoord> toMesh;
+    std::uint32_t nextVersion = 1;
+    std::size_t meshCount = 0;
+    std::size_t vertexCount = 0;
+    std::size_t meshBytes = 0;
+
+    // QUAD_INDEX_PATTERN repeated for quadCapacity quads, shared by every chunk mesh.
+    EBO quadIndices;
+    std::size_t quadCapacity = 0;
+
+    /**
+     * Snapshots a chunk and submits it to the workers.
+     *
+     * @param world The world being drawn.
+     * @param coord The chunk coordinate.
+     */
+    void schedule(const World& world, ChunkCoord coord);
+
+    /**
+     * Replaces a chunk's mesh with a finished one, unless a newer job has been submitted since.
+     *
+     * @param result The finished mesh.
+     */
+    void upload(MeshResult& result);
+
+    /**
+     * Grows the shared quad index buffer to hold at least the given number of quads.
+     * Its ID is kept, so the VAOs that reference it stay valid.
+     *
+     * @param quads The number of quads the next mesh needs.
+     */
+    void reserveQuads(std::size_t quads);
+
+    // Deletes a chunk's mesh, if it has one.
+    void releaseMesh(RenderChunk& chunk);
 
-    }
+    /**
+     * Returns true if any of the given sections lies against the neighbor at the given offset,
+     * so editing them can change that neighbor's mesh.
+     *
+     * @param sections Bit mask of section indices.
+     * @param dx Neighbor x-offset, in [-1, 1].
+     * @param dy Neighbor y-offset, in [-1, 1].
+     * @param dz Neighbor z-offset, in [-1, 1].
+     */
+    static bool touchesNeighbor(std::uint64_t sections, int dx, int dy, int dz);
 };
 
-#endif
\ No newline at end of file
+#endif
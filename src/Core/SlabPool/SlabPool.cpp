@@ -0,0 +1,136 @@
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "SlabPool.h"
+
+
+// Reserves and commits memory for a slab, trying huge pages first when requested.
+static void* allocateSlabMemory(std::size_t bytes, bool hugePages, bool& gotHugePages)
+{
+    gotHugePages = false;
+#ifdef _WIN32
+    if (hugePages)
+    {
+        // Needs the "Lock pages in memory" privilege, fails otherwise.
+        const SIZE_T largePage = GetLargePageMinimum();
+        if (largePage != 0 && bytes % largePage == 0)
+        {
+            void* memory = VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (memory)
+            {
+                gotHugePages = true;
+                return memory;
+            }
+        }
+    }
+    return VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    if (hugePages)
+    {
+#ifdef MAP_HUGETLB
+        void* memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory != MAP_FAILED)
+        {
+            gotHugePages = true;
+            return memory;
+        }
+#endif
+    }
+    void* memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return nullptr;
+#ifdef MADV_HUGEPAGE
+    // Let transparent huge pages back the slab if explicit huge pages are unavailable.
+    if (hugePages)
+        madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+    return memory;
+#endif
+}
+
+static void freeSlabMemory(void* memory, std::size_t bytes)
+{
+#ifdef _WIN32
+    (void)bytes;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, bytes);
+#endif
+}
+
+SlabPool::SlabPool(std::size_t slotSize, bool useHugePages)
+    : slotSize((slotSize + 63) / 64 * 64), useHugePages(useHugePages)
+{
+    slotsPerSlab = this->slotSize >= SLAB_BYTES ? 1 : SLAB_BYTES / this->slotSize;
+}
+
+SlabPool::~SlabPool()
+{
+    for (const Slab& slab : slabs)
+        freeSlabMemory(slab.memory, slab.bytes);
+}
+
+void* SlabPool::allocate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList)
+        grow();
+
+    FreeSlot* slot = freeList;
+    freeList = slot->next;
+
+    slotsInUse++;
+    totalAllocations++;
+    if (slotsInUse > peakSlotsInUse)
+        peakSlotsInUse = slotsInUse;
+    return slot;
+}
+
+void SlabPool::deallocate(void* slot)
+{
+    if (!slot)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeSlot* freed = static_cast<FreeSlot*>(slot);
+    freed->next = freeList;
+    freeList = freed;
+    slotsInUse--;
+}
+
+SlabPoolStats SlabPool::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t hugePageSlabs = 0;
+    for (const Slab& slab : slabs)
+        hugePageSlabs += slab.hugePages;
+    return SlabPoolStats{ slotSize, slotsPerSlab, slabs.size(), slotsInUse, peakSlotsInUse, totalAllocations, hugePageSlabs };
+}
+
+void SlabPool::grow()
+{
+    // Round slabs up to whole huge pages so they are eligible for them.
+    const std::size_t bytes = (slotSize * slotsPerSlab + SLAB_BYTES - 1) / SLAB_BYTES * SLAB_BYTES;
+    bool gotHugePages;
+    void* memory = allocateSlabMemory(bytes, useHugePages, gotHugePages);
+    if (!memory)
+        throw std::bad_alloc();
+    slabs.push_back(Slab{ memory, bytes, gotHugePages });
+
+    // Thread the slots onto the free list in address order.
+    char* base = static_cast<char*>(memory);
+    for (std::size_t i = slotsPerSlab; i-- > 0;)
+    {
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(base + i * slotSize);
+        slot->next = freeList;
+        freeList = slot;
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef SLAB_POOL_H
+#define SLAB_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Size of one slab, matching the common 2 MB huge page size.
+constexpr std::size_t SLAB_BYTES = 2 * 1024 * 1024;
+
+// Occupancy statistics of a SlabPool.
+struct SlabPoolStats
+{
+    std::size_t slotSize;
+    std::size_t slotsPerSlab;
+    std::size_t slabCount;
+    std::size_t slotsInUse;
+    std::size_t peakSlotsInUse;
+    std::size_t totalAllocations;
+    std::size_t hugePageSlabs;
+
+    // Fraction of allocated slots currently handed out.
+    double occupancy() const
+    {
+        const std::size_t slots = slabCount * slotsPerSlab;
+        return slots == 0 ? 0.0 : (double)slotsInUse / (double)slots;
+    }
+};
+
+/*
+ * Fixed-size allocator that carves large slabs into equal slots. Freed slots
+ * go onto an intrusive free list and are handed out again before any new slab
+ * is requested, so constantly loading and unloading chunks never goes through
+ * the general heap. Slabs are only returned to the system when the pool is
+ * destroyed. All methods are thread-safe.
+ */
+class SlabPool
+{
+public:
+    /**
+     * Constructor creates an empty pool; slabs are allocated on demand.
+     *
+     * @param slotSize Size of every allocation, rounded up to a multiple of 64 bytes.
+     * @param useHugePages Back slabs with huge pages where the OS allows it, falling back to regular pages.
+     */
+    SlabPool(std::size_t slotSize, bool useHugePages = false);
+    ~SlabPool();
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // Returns an uninitialized, 64-byte aligned slot of getSlotSize() bytes.
+    void* allocate();
+
+    // Returns a slot obtained from allocate() to the pool.
+    void deallocate(void* slot);
+
+    // Returns the size of each slot.
+    std::size_t getSlotSize() const { return slotSize; }
+
+    // Returns a snapshot of the pool's occupancy statistics.
+    SlabPoolStats getStats() const;
+
+private:
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    struct Slab
+    {
+        void* memory;
+        std::size_t bytes;
+        bool hugePages;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Slab> slabs;
+    FreeSlot* freeList = nullptr;
+
+    std::size_t slotSize;
+    std::size_t slotsPerSlab;
+    bool useHugePages;
+
+    std::size_t slotsInUse = 0;
+    std::size_t peakSlotsInUse = 0;
+    std::size_t totalAllocations = 0;
+
+    // Allocates a new slab and threads its slots onto the free list.
+    void grow();
+};
+
+// Owning handle to one slot of a SlabPool, returned to the pool when destroyed.
+template <typename T>
+class PoolBuffer
+{
+public:
+    PoolBuffer() = default;
+
+    // Allocates an uninitialized slot from the pool.
+    explicit PoolBuffer(SlabPool& pool)
+        : pool(&pool), data(static_cast<T*>(pool.allocate()))
+    {
+    }
+
+    ~PoolBuffer() { reset(); }
+
+    PoolBuffer(const PoolBuffer&) = delete;
+    PoolBuffer& operator=(const PoolBuffer&) = delete;
+
+    PoolBuffer(PoolBuffer&& other) noexcept
+        : pool(other.pool), data(other.data)
+    {
+        other.pool = nullptr;
+        other.data = nullptr;
+    }
+
+    PoolBuffer& operator=(PoolBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            pool = other.pool;
+            data = other.data;
+            other.pool = nullptr;
+            other.data = nullptr;
+        }
+        return *this;
+    }
+
+    // Returns the slot to its pool.
+    void reset()
+    {
+        if (data)
+            pool->deallocate(data);
+        pool = nullptr;
+        data = nullptr;
+    }
+
+    T* get() const { return data; }
+    T& operator[](std::size_t i) const { return data[i]; }
+    explicit operator bool() const { return data != nullptr; }
+
+    // Returns the number of bytes owned by the buffer.
+    std::size_t bytes() const { return data ? pool->getSlotSize() : 0; }
+
+private:
+    SlabPool* pool = nullptr;
+    T* data = nullptr;
+};
+
+#endif
@@ -23,18 +23,11 @@ Texture::Texture(GLenum target, GLenum textureUnit)
     glTexParameteri(TARGET, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     stbi_set_flip_vertically_on_load(true);
-
-    // Define texture offsets here
-    textureOffsets = {
-        {TextureType::Dirt, TexelOffset{0, 0}},
-        {TextureType::GrassSide, TexelOffset{TILE_SIZE * 1, 0}},
-        {TextureType::GrassTop, TexelOffset{TILE_SIZE * 2, 0}}
-    };
 }
 
-void Texture::load(const char* filename, GLenum format) const
+void Texture::load(const char* filename, GLenum format)
 {
-    int width, height, nrChannels;
+    int nrChannels;
     unsigned char* data = stbi_load(filename, &width, &height, &nrChannels, 0);
     if (data) {
         glTexImage2D(TARGET, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, data);
@@ -49,14 +42,4 @@ void Texture::load(const char* filename, GLenum format) const
 void Texture::bind() const
 {
     glBindTexture(TARGET, ID);
-}
-
-TexelOffset Texture::getTexelOffset(TextureType textureType) const
-{
-    auto it = textureOffsets.find(textureType);
-    if (it == textureOffsets.end()) {
-        std::cout << "textureType not found, default TexelOffset value is given" << std::endl;
-        return TexelOffset{ 0, 0 };
-    };
-    return it->second;
 }
\ No newline at end of file
@@ -4,21 +4,6 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-#include <unordered_map>
-
-
-enum class TextureType
-{
-    Dirt,
-    GrassSide,
-    GrassTop
-};
-
-struct TexelOffset
-{
-    float x_offset;
-    float y_offset;
-};
 
 class Texture
 {
@@ -32,8 +17,9 @@ public:
     // How many pixels wide each tile on the texture atlas is.
     const float TILE_SIZE = 16.0f;
 
-    // Hashmap containing key value pairs of the texture type to texel offset.
-    std::unordered_map<TextureType, TexelOffset> textureOffsets;
+    // Size of the loaded texture in pixels.
+    int width = 0;
+    int height = 0;
 
     /**
      * Constructor generates the texture.
@@ -49,18 +35,10 @@ public:
      * @param filename The path to the texture file to be loaded.
      * @param format The texture format of the input file (e.g., GL_RGB, GL_RGBA).
      */
-    void load(const char* filename, GLenum format) const;
+    void load(const char* filename, GLenum format);
 
     // Binds this texture to the target state
     void bind() const;
-
-    /**
-     * Returns the TexelOffset of the given texture.
-     *
-     * @param textureType The texture to get the TexelOffset of.
-     * @return The TexelOffset.
-     */
-    TexelOffset getTexelOffset(TextureType textureType) const;
 };
 
 #endif
\ No newline at end of file
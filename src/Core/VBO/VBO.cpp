@@ -1,6 +1,6 @@
 #include "VBO.h"
 
-VBO::VBO(GLfloat* vertices, GLsizeiptr size) {
+VBO::VBO(const void* vertices, GLsizeiptr size) {
     glGenBuffers(1, &ID);
     bind();
     glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
@@ -9,8 +9,8 @@ public:
     // VBO ID
     GLuint ID;
 
-    // Constructor for VBO
-    VBO(GLfloat* vertices, GLsizeiptr size);
+    // Constructor for VBO, uploading size bytes of vertex data of any type
+    VBO(const void* vertices, GLsizeiptr size);
     
     // Binds the VBO to GL_ARRAY_BUFFER
     void bind() const;
@@ -0,0 +1,14 @@
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <cstdint>
+
+// Numeric identifier of a block type, stored once per voxel.
+using BlockID = std::uint16_t;
+
+// Built-in block types
+constexpr BlockID BLOCK_AIR = 0;
+constexpr BlockID BLOCK_DIRT = 1;
+constexpr BlockID BLOCK_GRASS = 2;
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef BLOCK_LAYOUT_H
+#define BLOCK_LAYOUT_H
+
+#include <cstdint>
+
+/*
+ * Index layouts for cubic block arrays of Size^3 entries. The layout used by
+ * chunk sections is chosen at compile time: define VOXEL_MORTON_LAYOUT to
+ * store blocks in Z-order instead of x-fastest linear order.
+ */
+
+// x varies fastest, then y, then z. Neighbors along z are Size^2 entries apart.
+template <int Size>
+struct LinearLayout
+{
+    static int index(int x, int y, int z)
+    {
+        return x + Size * (y + Size * z);
+    }
+};
+
+// Interleaves the bits of x, y and z (Z-order), keeping all six neighbors of most blocks within a few cache lines.
+template <int Size>
+struct MortonLayout
+{
+    static_assert(Size > 0 && (Size & (Size - 1)) == 0 && Size <= 1024, "Morton layout needs a power-of-two size up to 1024");
+
+    static int index(int x, int y, int z)
+    {
+        return (int)(spreadBits((std::uint32_t)x) | (spreadBits((std::uint32_t)y) << 1) | (spreadBits((std::uint32_t)z) << 2));
+    }
+
+    // Inserts two zero bits between each of the low 10 bits of v.
+    static std::uint32_t spreadBits(std::uint32_t v)
+    {
+        v &= 0x000003ff;
+        v = (v | (v << 16)) & 0xff0000ff;
+        v = (v | (v << 8)) & 0x0300f00f;
+        v = (v | (v << 4)) & 0x030c30c3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
+};
+
+#ifdef VOXEL_MORTON_LAYOUT
+template <int Size>
+using BlockLayout = MortonLayout<Size>;
+#else
+template <int Size>
+using BlockLayout = LinearLayout<Size>;
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#include "BlockRegistry.h"
+
+
+// Tiles of the texture atlas, numbered left to right from the top-left corner.
+static const std::uint16_t TILE_DIRT = 0;
+static const std::uint16_t TILE_GRASS_SIDE = 1;
+static const std::uint16_t TILE_GRASS_TOP = 2;
+
+BlockRegistry& BlockRegistry::instance()
+{
+    static BlockRegistry registry;
+    return registry;
+}
+
+BlockRegistry::BlockRegistry()
+{
+    registerBlock(BlockDefinition{
+        "air", false,
+        { 0, 0, 0, 0, 0, 0 },
+        0, CollisionShape::None
+    });
+    registerBlock(BlockDefinition{
+        "dirt", true,
+        { TILE_DIRT, TILE_DIRT, TILE_DIRT, TILE_DIRT, TILE_DIRT, TILE_DIRT },
+        0, CollisionShape::Cube
+    });
+    registerBlock(BlockDefinition{
+        "grass", true,
+        { TILE_GRASS_SIDE, TILE_GRASS_SIDE, TILE_GRASS_TOP, TILE_DIRT, TILE_GRASS_SIDE, TILE_GRASS_SIDE },
+        0, CollisionShape::Cube
+    });
+}
+
+BlockID BlockRegistry::registerBlock(const BlockDefinition& definition)
+{
+    const BlockID id = (BlockID)names.size();
+    opaque.push_back(definition.opaque ? 1 : 0);
+    tiles.insert(tiles.end(), definition.tiles.begin(), definition.tiles.end());
+    lightEmission.push_back(definition.lightEmission);
+    collision.push_back(definition.collision);
+    names.push_back(definition.name);
+    return id;
+}
@@ -0,0 +1,106 @@
+#ifndef BLOCK_REGISTRY_H
+#define BLOCK_REGISTRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Block/Block.h"
+
+// The six faces of a block, in the order used by per-face tables.
+enum class BlockFace : std::uint8_t
+{
+    PosX,
+    NegX,
+    PosY,
+    NegY,
+    PosZ,
+    NegZ
+};
+
+constexpr int FACE_COUNT = 6;
+
+// The shape physics collides with.
+enum class CollisionShape : std::uint8_t
+{
+    None,
+    Cube
+};
+
+// Properties used to register a block type.
+struct BlockDefinition
+{
+    std::string name;
+
+    // Whether the block hides the faces of its neighbors.
+    bool opaque;
+
+    // Texture atlas tile of each face, indexed by BlockFace.
+    std::array<std::uint16_t, FACE_COUNT> tiles;
+
+    // Light level emitted by the block, in [0, 15].
+    std::uint8_t lightEmission;
+
+    CollisionShape collision;
+};
+
+/*
+ * Table of every block type's properties, stored as one dense array per
+ * property indexed by block ID, so hot loops read a property with a single
+ * indexed load. Block IDs must be registered before they are looked up.
+ */
+class BlockRegistry
+{
+public:
+    // Returns the registry shared by the engine, with the built-in blocks registered.
+    static BlockRegistry& instance();
+
+    /**
+     * Registers a new block type.
+     *
+     * @param definition The block's properties.
+     * @return The ID assigned to the block.
+     */
+    BlockID registerBlock(const BlockDefinition& definition);
+
+    // Returns true if the block hides the faces of its neighbors.
+    bool isOpaque(BlockID block) const { return opaque[block] != 0; }
+
+    // Returns the atlas tile of one face of the block.
+    std::uint16_t getTile(BlockID block, BlockFace face) const
+    {
+        return tiles[(std::size_t)block * FACE_COUNT + (std::size_t)face];
+    }
+
+    // Returns the light level emitted by the block.
+    std::uint8_t getLightEmission(BlockID block) const { return lightEmission[block]; }
+
+    // Returns the shape physics collides with.
+    CollisionShape getCollision(BlockID block) const { return collision[block]; }
+
+    // Returns the name the block was registered with.
+    const std::string& getName(BlockID block) const { return names[block]; }
+
+    // Returns the opacity table (1 for opaque, 0 otherwise) indexed by block ID.
+    const std::uint8_t* getOpacityTable() const { return opaque.data(); }
+
+    // Returns the light emission table indexed by block ID.
+    const std::uint8_t* getEmissionTable() const { return lightEmission.data(); }
+
+    // Returns the number of registered blocks.
+    std::size_t getBlockCount() const { return names.size(); }
+
+private:
+    // Constructor registers the built-in blocks in the order of their BLOCK_* IDs.
+    BlockRegistry();
+
+    std::vector<std::uint8_t> opaque;
+    std::vector<std::uint16_t> tiles;
+    std::vector<std::uint8_t> lightEmission;
+    std::vector<CollisionShape> collision;
+    std::vector<std::string> names;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include <algorithm>
+
+#include "Brickmap.h"
+#include "../VoxelStorage/Raycast.h"
+
+
+Brickmap::Brickmap(int sizeInBricks)
+    : grid((std::size_t)sizeInBricks * sizeInBricks * sizeInBricks, nullptr),
+      sizeInBricks(sizeInBricks), size(sizeInBricks * BRICK_SIZE), origin(-(sizeInBricks * BRICK_SIZE) / 2)
+{
+}
+
+void Brickmap::setBlock(int x, int y, int z, BlockID block)
+{
+    if (!contains(x, y, z))
+        return;
+
+    const int rx = x - origin, ry = y - origin, rz = z - origin;
+    Brick*& cell = grid[brickIndex(rx, ry, rz)];
+    const int i = localIndex(rx, ry, rz);
+
+    if (!cell)
+    {
+        if (block == BLOCK_AIR)
+            return;
+        cell = allocateBrick(BLOCK_AIR);
+    }
+    else if (cell->shared)
+    {
+        if (cell->blocks[i] == block)
+            return;
+        cell = allocateBrick(cell->blocks[i]);
+    }
+
+    Brick* brick = cell;
+    const BlockID previous = brick->blocks[i];
+    if (previous == block)
+        return;
+    brick->blocks[i] = block;
+
+    if (previous == BLOCK_AIR)
+        brick->nonAirCount++;
+    else if (block == BLOCK_AIR)
+        brick->nonAirCount--;
+
+    // Drop bricks that became empty, and swap bricks that became a single solid block for the shared one.
+    if (brick->nonAirCount == 0)
+    {
+        releaseBrick(brick);
+        cell = nullptr;
+    }
+    else if (brick->nonAirCount == BRICK_VOLUME
+        && std::all_of(brick->blocks.begin(), brick->blocks.end(), [block](BlockID b) { return b == block; }))
+    {
+        releaseBrick(brick);
+        cell = solidBrick(block);
+    }
+}
+
+std::size_t Brickmap::memoryUsage() const
+{
+    return grid.capacity() * sizeof(Brick*)
+        + bricks.size() * sizeof(Brick)
+        + solidBricks.size() * sizeof(Brick);
+}
+
+bool Brickmap::raycast(glm::vec3 rayOrigin, glm::vec3 direction, float maxDistance, RaycastHit& hit) const
+{
+    return traverseLeaves(rayOrigin, direction, maxDistance, glm::ivec3(origin), size,
+        [this](glm::ivec3 cell, glm::ivec3& leafMin, int& leafSize) {
+            const glm::ivec3 rel = cell - origin;
+            const Brick* brick = grid[brickIndex(rel.x, rel.y, rel.z)];
+            if (!brick)
+            {
+                leafSize = BRICK_SIZE;
+                leafMin = rel - rel % BRICK_SIZE + origin;
+                return BLOCK_AIR;
+            }
+            leafSize = 1;
+            leafMin = cell;
+            return brick->blocks[localIndex(rel.x, rel.y, rel.z)];
+        },
+        hit);
+}
+
+Brickmap::Brick* Brickmap::allocateBrick(BlockID block)
+{
+    Brick* brick;
+    if (!freeBricks.empty())
+    {
+        brick = freeBricks.back();
+        freeBricks.pop_back();
+    }
+    else
+    {
+        bricks.push_back(std::make_unique<Brick>());
+        brick = bricks.back().get();
+    }
+
+    brick->blocks.fill(block);
+    brick->nonAirCount = block == BLOCK_AIR ? 0 : BRICK_VOLUME;
+    brick->shared = false;
+    return brick;
+}
+
+Brickmap::Brick* Brickmap::solidBrick(BlockID block)
+{
+    std::unique_ptr<Brick>& brick = solidBricks[block];
+    if (!brick)
+    {
+        brick = std::make_unique<Brick>();
+        brick->blocks.fill(block);
+        brick->nonAirCount = BRICK_VOLUME;
+        brick->shared = true;
+    }
+    return brick.get();
+}
+
+void Brickmap::releaseBrick(Brick* brick)
+{
+    freeBricks.push_back(brick);
+}
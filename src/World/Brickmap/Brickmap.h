@@ -0,0 +1,126 @@
+#ifndef BRICKMAP_H
+#define BRICKMAP_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <../include/glm/glm.hpp>
+
+#include "../Block/Block.h"
+#include "../VoxelStorage/VoxelStorage.h"
+
+// Number of blocks along each axis of a brick.
+constexpr int BRICK_SIZE = 8;
+constexpr int BRICK_VOLUME = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+
+// Default brickmap size, covering 1024 blocks along each axis.
+constexpr int BRICKMAP_DEFAULT_SIZE = 128;
+
+/*
+ * Two-level block storage: a dense grid of pointers to 8^3 bricks covering a
+ * cube centered on the origin. Empty bricks are null, bricks filled with a
+ * single block point at one shared brick per block ID, and only mixed bricks
+ * own their 1 KB of block data.
+ */
+class Brickmap final : public VoxelStorage
+{
+public:
+    /**
+     * Constructor creates a brickmap filled with air.
+     *
+     * @param sizeInBricks Number of bricks along each axis of the grid.
+     */
+    explicit Brickmap(int sizeInBricks = BRICKMAP_DEFAULT_SIZE);
+
+    BlockID getBlock(int x, int y, int z) const override
+    {
+        if (!contains(x, y, z))
+            return BLOCK_AIR;
+        const Brick* brick = grid[brickIndex(x - origin, y - origin, z - origin)];
+        if (!brick)
+            return BLOCK_AIR;
+        return brick->blocks[localIndex(x - origin, y - origin, z - origin)];
+    }
+
+    // Sets a block, allocating a brick on first write and releasing it once it is empty or solid. Ignored outside the map.
+    void setBlock(int x, int y, int z, BlockID block) override;
+
+    std::size_t memoryUsage() const override;
+
+    /**
+     * Finds the first non-air block along a ray, skipping empty bricks in one step.
+     *
+     * @param rayOrigin Start of the ray in world space.
+     * @param direction Direction of the ray (does not need to be normalized).
+     * @param maxDistance Maximum distance along the ray, in units of the direction's length.
+     * @param hit Receives the hit information.
+     * @return True if a block was hit.
+     */
+    bool raycast(glm::vec3 rayOrigin, glm::vec3 direction, float maxDistance, RaycastHit& hit) const;
+
+    // Returns the number of bricks that own their block data.
+    std::size_t getOwnedBrickCount() const { return bricks.size() - freeBricks.size(); }
+
+    // Returns the minimum corner of the region covered by the map.
+    int getOrigin() const { return origin; }
+
+    // Returns the number of blocks along each axis of the map.
+    int getSize() const { return size; }
+
+private:
+    struct Brick
+    {
+        std::array<BlockID, BRICK_VOLUME> blocks;
+
+        // Number of non-air blocks in the brick.
+        int nonAirCount;
+
+        // True for the per-block solid bricks referenced from many grid cells.
+        bool shared;
+    };
+
+    // One pointer per brick, null for empty bricks.
+    std::vector<Brick*> grid;
+
+    // Storage for bricks owning their block data; released bricks are recycled through freeBricks.
+    std::vector<std::unique_ptr<Brick>> bricks;
+    std::vector<Brick*> freeBricks;
+
+    // One shared brick per block ID used to fill a whole brick.
+    std::unordered_map<BlockID, std::unique_ptr<Brick>> solidBricks;
+
+    int sizeInBricks;
+    int size;
+    int origin;
+
+    bool contains(int x, int y, int z) const
+    {
+        return x >= origin && y >= origin && z >= origin && x < origin + size && y < origin + size && z < origin + size;
+    }
+
+    // Returns the grid cell of a position relative to the map origin.
+    std::size_t brickIndex(int rx, int ry, int rz) const
+    {
+        return (std::size_t)(rx / BRICK_SIZE) + sizeInBricks * ((std::size_t)(ry / BRICK_SIZE) + (std::size_t)sizeInBricks * (rz / BRICK_SIZE));
+    }
+
+    // Returns the index of a position relative to the map origin within its brick.
+    static int localIndex(int rx, int ry, int rz)
+    {
+        return (rx % BRICK_SIZE) + BRICK_SIZE * ((ry % BRICK_SIZE) + BRICK_SIZE * (rz % BRICK_SIZE));
+    }
+
+    // Returns a brick owning its data, filled with the given block.
+    Brick* allocateBrick(BlockID block);
+
+    // Returns the shared brick filled with the given block.
+    Brick* solidBrick(BlockID block);
+
+    // Returns an owned brick to the free list.
+    void releaseBrick(Brick* brick);
+};
+
+#endif
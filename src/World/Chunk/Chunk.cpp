@@ -0,0 +1,72 @@
+#include "Chunk.h"
+
+
+// Air section shared by every empty section slot; the extra reference held here means it is always copied before a write.
+static const std::shared_ptr<ChunkSection>& emptySection()
+{
+    static const std::shared_ptr<ChunkSection> section = std::make_shared<ChunkSection>(BLOCK_AIR);
+    return section;
+}
+
+ChunkSnapshot::ChunkSnapshot()
+    : coord{ 0, 0, 0 }
+{
+    sections.fill(emptySection());
+}
+
+bool ChunkSnapshot::isEmpty() const
+{
+    for (const std::shared_ptr<const ChunkSection>& section : sections)
+    {
+        if (!section->isEmpty())
+            return false;
+    }
+    return true;
+}
+
+Chunk::Chunk(ChunkCoord coord)
+    : coord(coord)
+{
+    sections.fill(emptySection());
+}
+
+void Chunk::fill(BlockID block)
+{
+    sections.fill(block == BLOCK_AIR ? emptySection() : std::make_shared<ChunkSection>(block));
+}
+
+bool Chunk::isEmpty() const
+{
+    for (const std::shared_ptr<ChunkSection>& section : sections)
+    {
+        if (!section->isEmpty())
+            return false;
+    }
+    return true;
+}
+
+std::size_t Chunk::memoryUsage() const
+{
+    std::size_t total = 0;
+    for (const std::shared_ptr<ChunkSection>& section : sections)
+        total += section->memoryUsage();
+    return total;
+}
+
+ChunkSection& Chunk::mutableSection(int i)
+{
+    // Only this chunk can hand out new references, so a count of one cannot grow behind our back.
+    if (sections[i].use_count() > 1)
+        sections[i] = std::make_shared<ChunkSection>(*sections[i]);
+    return *sections[i];
+}
+
+ChunkSnapshot Chunk::snapshot() const
+{
+    ChunkSnapshot view;
+    view.coord = coord;
+    view.loaded = true;
+    for (int i = 0; i < SECTIONS_PER_CHUNK; i++)
+        view.sections[i] = sections[i];
+    return view;
+}
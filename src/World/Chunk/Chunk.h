@@ -0,0 +1,203 @@
+#ifndef CHUNK_H
+#define CHUNK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "../Block/Block.h"
+#include "../ChunkSection/ChunkSection.h"
+
+// Number of blocks along each axis of a chunk, can be overridden at compile time.
+#ifndef VOXEL_CHUNK_SIZE
+#define VOXEL_CHUNK_SIZE 32
+#endif
+
+constexpr int CHUNK_SIZE = VOXEL_CHUNK_SIZE;
+constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
+constexpr int CHUNK_VOLUME = CHUNK_AREA * CHUNK_SIZE;
+
+// Number of sections along each axis of a chunk.
+constexpr int SECTIONS_PER_AXIS = CHUNK_SIZE / SECTION_SIZE;
+constexpr int SECTIONS_PER_CHUNK = SECTIONS_PER_AXIS * SECTIONS_PER_AXIS * SECTIONS_PER_AXIS;
+
+static_assert(CHUNK_SIZE % SECTION_SIZE == 0, "CHUNK_SIZE must be a multiple of SECTION_SIZE");
+static_assert(SECTIONS_PER_CHUNK <= 64, "dirty section flags must fit in 64 bits");
+
+// Position of a chunk in chunk space (block position divided by CHUNK_SIZE).
+struct ChunkCoord
+{
+    int x;
+    int y;
+    int z;
+
+    bool operator==(const ChunkCoord& other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+
+    bool operator!=(const ChunkCoord& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/*
+ * Immutable view of a chunk at one point in time. Taking a snapshot only
+ * copies the chunk's section pointers, and later edits to the chunk copy the
+ * sections they touch instead of modifying them, so a snapshot can be read
+ * from any thread without locking while the world keeps changing.
+ */
+class ChunkSnapshot
+{
+public:
+    // Position of the chunk in chunk space.
+    ChunkCoord coord;
+
+    // Constructor creates a snapshot of an unloaded chunk, which reads as air.
+    ChunkSnapshot();
+
+    /**
+     * Returns the block at the given local position.
+     *
+     * @param x Local x-position, in [0, CHUNK_SIZE).
+     * @param y Local y-position, in [0, CHUNK_SIZE).
+     * @param z Local z-position, in [0, CHUNK_SIZE).
+     * @return The ID of the block.
+     */
+    BlockID getBlock(int x, int y, int z) const
+    {
+        return sections[sectionIndex(x, y, z)]->getBlock(x % SECTION_SIZE, y % SECTION_SIZE, z % SECTION_SIZE);
+    }
+
+    /**
+     * Copies the CHUNK_SIZE blocks of one x-row into a contiguous buffer.
+     *
+     * @param y Local y-position of the row.
+     * @param z Local z-position of the row.
+     * @param out Receives CHUNK_SIZE block IDs, ordered by x.
+     */
+    void copyRow(int y, int z, BlockID* out) const
+    {
+        for (int x = 0; x < CHUNK_SIZE; x += SECTION_SIZE)
+            sections[sectionIndex(x, y, z)]->copyRow(y % SECTION_SIZE, z % SECTION_SIZE, out + x);
+    }
+
+    // Returns the section with the given section index.
+    const ChunkSection& getSection(int i) const { return *sections[i]; }
+
+    // Returns false if the snapshot was taken of a chunk that was not loaded.
+    bool isLoaded() const { return loaded; }
+
+    // Returns true if every block in the snapshot is air.
+    bool isEmpty() const;
+
+    // Returns the index of the section containing the given local block (x varies fastest).
+    static int sectionIndex(int x, int y, int z)
+    {
+        return x / SECTION_SIZE + SECTIONS_PER_AXIS * (y / SECTION_SIZE + SECTIONS_PER_AXIS * (z / SECTION_SIZE));
+    }
+
+private:
+    friend class Chunk;
+
+    std::array<std::shared_ptr<const ChunkSection>, SECTIONS_PER_CHUNK> sections;
+    bool loaded = false;
+};
+
+class Chunk
+{
+public:
+    // Position of this chunk in chunk space.
+    ChunkCoord coord;
+
+    /**
+     * Constructor creates a chunk filled with air.
+     *
+     * @param coord The position of the chunk in chunk space.
+     */
+    Chunk(ChunkCoord coord);
+
+    /**
+     * Returns the block at the given local position.
+     *
+     * @param x Local x-position, in [0, CHUNK_SIZE).
+     * @param y Local y-position, in [0, CHUNK_SIZE).
+     * @param z Local z-position, in [0, CHUNK_SIZE).
+     * @return The ID of the block.
+     */
+    BlockID getBlock(int x, int y, int z) const
+    {
+        return sections[sectionIndex(x, y, z)]->getBlock(x % SECTION_SIZE, y % SECTION_SIZE, z % SECTION_SIZE);
+    }
+
+    /**
+     * Sets the block at the given local position, copying the section first if a snapshot shares it.
+     *
+     * @param x Local x-position, in [0, CHUNK_SIZE).
+     * @param y Local y-position, in [0, CHUNK_SIZE).
+     * @param z Local z-position, in [0, CHUNK_SIZE).
+     * @param block The ID of the new block.
+     */
+    void setBlock(int x, int y, int z, BlockID block)
+    {
+        const int i = sectionIndex(x, y, z);
+        if (sections[i]->getBlock(x % SECTION_SIZE, y % SECTION_SIZE, z % SECTION_SIZE) != block)
+        {
+            mutableSection(i).setBlock(x % SECTION_SIZE, y % SECTION_SIZE, z % SECTION_SIZE, block);
+            markSectionDirty(i);
+        }
+    }
+
+    // Sets every block in the chunk to the given block.
+    void fill(BlockID block);
+
+    // Returns true if every block in the chunk is air.
+    bool isEmpty() const;
+
+    // Returns the approximate number of heap bytes used by the chunk's sections.
+    std::size_t memoryUsage() const;
+
+    // Returns the section with the given section index.
+    const ChunkSection& getSection(int i) const { return *sections[i]; }
+
+    /**
+     * Returns the section with the given section index for writing. If a snapshot still
+     * shares the section it is copied first, leaving the snapshot's version untouched.
+     *
+     * @param i The section index.
+     * @return The section, owned by this chunk alone.
+     */
+    ChunkSection& mutableSection(int i);
+
+    // Flags a section whose meshes and light need rebuilding.
+    void markSectionDirty(int i) { dirtySections |= std::uint64_t(1) << i; }
+
+    // Returns one bit per section (bit i for section index i) flagging sections edited since the last clear.
+    std::uint64_t getDirtySections() const { return dirtySections; }
+
+    // Clears every dirty section flag.
+    void clearDirtySections() { dirtySections = 0; }
+
+    /**
+     * Returns an immutable view of the chunk's current contents in O(1).
+     * Must be called from the thread that edits the chunk; the snapshot can then be read from any thread.
+     */
+    ChunkSnapshot snapshot() const;
+
+    // Returns the index of the section containing the given local block (x varies fastest).
+    static int sectionIndex(int x, int y, int z)
+    {
+        return ChunkSnapshot::sectionIndex(x, y, z);
+    }
+
+private:
+    // Palette-compressed sections making up the chunk, shared with snapshots until written.
+    std::array<std::shared_ptr<ChunkSection>, SECTIONS_PER_CHUNK> sections;
+
+    // Sections edited since the dirty flags were last cleared.
+    std::uint64_t dirtySections = 0;
+};
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef CHUNK_MAP_H
+#define CHUNK_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../Chunk/Chunk.h"
+
+/*
+ * Hash map from chunk coordinates to values, using open addressing with
+ * linear probing. Each coordinate is packed into a single 64-bit key (21 bits
+ * per axis, so chunk coordinates must lie in [-2^20, 2^20)). Keys and values
+ * live in two flat arrays, so a lookup touches only the key array until it
+ * hits and inserting never allocates unless the table grows.
+ */
+template <typename T>
+class ChunkMap
+{
+public:
+    /**
+     * Constructor allocates an empty table.
+     *
+     * @param initialCapacity Number of slots to start with, rounded up to a power of two.
+     */
+    explicit ChunkMap(std::size_t initialCapacity = 64)
+    {
+        std::size_t capacity = 8;
+        while (capacity < initialCapacity)
+            capacity *= 2;
+        keys.assign(capacity, EMPTY_KEY);
+        values.resize(capacity);
+    }
+
+    /**
+     * Returns a pointer to the value stored for the coordinate.
+     *
+     * @param coord The chunk coordinate to look up.
+     * @return The value, or nullptr if the coordinate is not in the map.
+     */
+    T* find(ChunkCoord coord)
+    {
+        const std::uint64_t key = packCoord(coord);
+        for (std::size_t i = slotFor(key);; i = (i + 1) & mask())
+        {
+            if (keys[i] == key)
+                return &values[i];
+            if (keys[i] == EMPTY_KEY)
+                return nullptr;
+        }
+    }
+
+    const T* find(ChunkCoord coord) const
+    {
+        return const_cast<ChunkMap*>(this)->find(coord);
+    }
+
+    /**
+     * Returns the value stored for the coordinate, inserting a default-constructed one if missing.
+     *
+     * @param coord The chunk coordinate to look up.
+     * @return The stored value.
+     */
+    T& operator[](ChunkCoord coord)
+    {
+        if ((count + 1) * 2 > keys.size())
+            rehash(keys.size() * 2);
+
+        const std::uint64_t key = packCoord(coord);
+        std::size_t i = slotFor(key);
+        for (; keys[i] != EMPTY_KEY; i = (i + 1) & mask())
+        {
+            if (keys[i] == key)
+                return values[i];
+        }
+
+        keys[i] = key;
+        count++;
+        return values[i];
+    }
+
+    /**
+     * Removes the coordinate from the map.
+     *
+     * @param coord The chunk coordinate to remove.
+     * @return True if the coordinate was in the map.
+     */
+    bool erase(ChunkCoord coord)
+    {
+        const std::uint64_t key = packCoord(coord);
+        std::size_t hole = slotFor(key);
+        for (; keys[hole] != key; hole = (hole + 1) & mask())
+        {
+            if (keys[hole] == EMPTY_KEY)
+                return false;
+        }
+
+        // Backward-shift deletion: pull later entries of the probe run into the hole so no tombstones are needed.
+        for (std::size_t i = (hole + 1) & mask(); keys[i] != EMPTY_KEY; i = (i + 1) & mask())
+        {
+            const std::size_t home = slotFor(keys[i]);
+            if (((i - home) & mask()) >= ((i - hole) & mask()))
+            {
+                keys[hole] = keys[i];
+                values[hole] = std::move(values[i]);
+                hole = i;
+            }
+        }
+
+        keys[hole] = EMPTY_KEY;
+        values[hole] = T();
+        count--;
+        return true;
+    }
+
+    // Removes every entry while keeping the allocated slots.
+    void clear()
+    {
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            if (keys[i] != EMPTY_KEY)
+            {
+                keys[i] = EMPTY_KEY;
+                values[i] = T();
+            }
+        }
+        count = 0;
+    }
+
+    /**
+     * Calls fn(ChunkCoord, T&) for every entry. The map must not be modified during iteration.
+     *
+     * @param fn The function to call.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            if (keys[i] != EMPTY_KEY)
+                fn(unpackCoord(keys[i]), values[i]);
+        }
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            if (keys[i] != EMPTY_KEY)
+                fn(unpackCoord(keys[i]), values[i]);
+        }
+    }
+
+    // Returns the number of entries in the map.
+    std::size_t size() const { return count; }
+
+    // Returns the number of slots in the table.
+    std::size_t capacity() const { return keys.size(); }
+
+    // Packs a chunk coordinate into a 63-bit key.
+    static std::uint64_t packCoord(ChunkCoord coord)
+    {
+        return ((std::uint64_t)(coord.x & AXIS_MASK) << (2 * AXIS_BITS))
+            | ((std::uint64_t)(coord.y & AXIS_MASK) << AXIS_BITS)
+            | (std::uint64_t)(coord.z & AXIS_MASK);
+    }
+
+    // Unpacks a key created by packCoord.
+    static ChunkCoord unpackCoord(std::uint64_t key)
+    {
+        return ChunkCoord{
+            signExtend(key >> (2 * AXIS_BITS)),
+            signExtend(key >> AXIS_BITS),
+            signExtend(key)
+        };
+    }
+
+private:
+    static constexpr int AXIS_BITS = 21;
+    static constexpr std::uint64_t AXIS_MASK = (std::uint64_t(1) << AXIS_BITS) - 1;
+
+    // Packed keys never set the top bit, so an all-ones key marks a free slot.
+    static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t(0);
+
+    std::vector<std::uint64_t> keys;
+    std::vector<T> values;
+    std::size_t count = 0;
+
+    std::size_t mask() const { return keys.size() - 1; }
+
+    // Returns the preferred slot of a key (64-bit finalizer from MurmurHash3).
+    std::size_t slotFor(std::uint64_t key) const
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return (std::size_t)key & mask();
+    }
+
+    static int signExtend(std::uint64_t bits)
+    {
+        const std::int64_t value = (std::int64_t)(bits & AXIS_MASK);
+        return (int)(value >= (std::int64_t(1) << (AXIS_BITS - 1)) ? value - (std::int64_t(1) << AXIS_BITS) : value);
+    }
+
+    // Moves every entry into a table with the given number of slots.
+    void rehash(std::size_t newCapacity)
+    {
+        std::vector<std::uint64_t> oldKeys(newCapacity, EMPTY_KEY);
+        std::vector<T> oldValues(newCapacity);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+
+        for (std::size_t i = 0; i < oldKeys.size(); i++)
+        {
+            if (oldKeys[i] == EMPTY_KEY)
+                continue;
+            std::size_t slot = slotFor(oldKeys[i]);
+            while (keys[slot] != EMPTY_KEY)
+                slot = (slot + 1) & mask();
+            keys[slot] = oldKeys[i];
+            values[slot] = std::move(oldValues[i]);
+        }
+    }
+};
+
+#endif
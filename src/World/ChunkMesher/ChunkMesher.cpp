@@ -0,0 +1,482 @@
+#include <algorithm>
+
+#include "ChunkMesher.h"
+#include "../../Core/Bits/Bits.h"
+
+static_assert(PADDED_SIZE <= 64, "binary meshing stores a padded column in one 64-bit word");
+
+// Corners of each face as offsets from the block's minimum corner, counter-clockwise seen from outside,
+// with the tile's (0, 0), (1, 0), (1, 1) and (0, 1) corners in that order. Indexed by BlockFace.
+static const int FACE_CORNERS[FACE_COUNT][4][3] = {
+    { { 1, 0, 1 }, { 1, 0, 0 }, { 1, 1, 0 }, { 1, 1, 1 } }, // PosX
+    { { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 } }, // NegX
+    { { 0, 1, 1 }, { 1, 1, 1 }, { 1, 1, 0 }, { 0, 1, 0 } }, // PosY
+    { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 } }, // NegY
+    { { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } }, // PosZ
+    { { 1, 0, 0 }, { 0, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } }, // NegZ
+};
+
+static const int CORNER_UVS[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+// Axes the tile's u and v run along on each face, indexed by BlockFace.
+static const int FACE_U_AXIS[FACE_COUNT] = { 2, 2, 0, 0, 0, 0 };
+static const int FACE_V_AXIS[FACE_COUNT] = { 1, 1, 2, 2, 1, 1 };
+
+// Offset of the neighbor across each face in the padded array, indexed by BlockFace.
+static const int NEIGHBOR_OFFSETS[FACE_COUNT] = { 1, -1, PADDED_SIZE, -PADDED_SIZE, PADDED_AREA, -PADDED_AREA };
+
+// Padded array stride of each axis.
+static const int AXIS_STRIDES[3] = { 1, PADDED_SIZE, PADDED_AREA };
+
+// Bit where the corner shades start in greedy mask keys, above the tile + 1.
+static const int GREEDY_SHADE_SHIFT = 17;
+
+// Face mask array stride of each axis.
+static const int CHUNK_STRIDES[3] = { 1, CHUNK_SIZE, CHUNK_AREA };
+
+ChunkMesher::ChunkMesher(MeshingMode mode)
+    : mode(mode), classifier(BlockRegistry::instance().getOpacityTable(), BlockRegistry::instance().getBlockCount())
+{
+    const BlockRegistry& registry = BlockRegistry::instance();
+    const std::size_t count = registry.getBlockCount();
+    opaque.assign(registry.getOpacityTable(), registry.getOpacityTable() + count);
+    emission.assign(registry.getEmissionTable(), registry.getEmissionTable() + count);
+    faceTiles.resize(count * FACE_COUNT);
+    for (std::size_t block = 0; block < count; block++)
+    {
+        for (int face = 0; face < FACE_COUNT; face++)
+        {
+            const std::uint16_t tile = registry.getTile((BlockID)block, (BlockFace)face);
+            faceTiles[block * FACE_COUNT + face] = tile;
+            tileCount = std::max(tileCount, (std::size_t)tile + 1);
+        }
+    }
+}
+
+void ChunkMesher::mesh(const PaddedChunk& blocks, std::vector<ChunkVertex>& out) const
+{
+    out.clear();
+    thread_local PaddedLight light;
+    light.compute(blocks, opaque.data(), emission.data());
+
+    if (mode == MeshingMode::BinaryGreedy)
+        meshBinaryGreedy(blocks, light.data(), out);
+    else if (mode == MeshingMode::Greedy)
+        meshGreedy(blocks, classify(blocks), light.data(), out);
+    else
+        meshCulled(blocks, classify(blocks), light.data(), out);
+}
+
+void ChunkMesher::meshFaces(const PaddedChunk& blocks, std::vector<std::uint32_t>& out) const
+{
+    out.clear();
+    const std::uint8_t* faces = classify(blocks);
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const BlockID* row = blocks.data() + PaddedChunk::index(0, y, z);
+            for (int x = 0; x < CHUNK_SIZE; x++)
+            {
+                const std::uint8_t visible = *faces++;
+                for (int face = 0; visible != 0 && face < FACE_COUNT; face++)
+                {
+                    if (!(visible >> face & 1))
+                        continue;
+
+                    // A tile the word has no room for falls back to the first one.
+                    const std::uint16_t tile = faceTiles[(std::size_t)row[x] * FACE_COUNT + face];
+                    out.push_back(packChunkFace(x, y, z, face, tile < CHUNK_FACE_MAX_TILES ? tile : 0));
+                }
+            }
+        }
+}
+
+const std::uint8_t* ChunkMesher::classify(const PaddedChunk& blocks) const
+{
+    thread_local std::vector<std::uint8_t> faces(CHUNK_VOLUME);
+    classifier.classify(blocks.data(), faces.data());
+    return faces.data();
+}
+
+void ChunkMesher::meshCulled(const PaddedChunk& blocks, const std::uint8_t* faces, const std::uint8_t* light, std::vector<ChunkVertex>& out) const
+{
+    const int size[3] = { 1, 1, 1 };
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const int row = PaddedChunk::index(0, y, z);
+            for (int x = 0; x < CHUNK_SIZE; x++)
+            {
+                const std::uint8_t visible = *faces++;
+                if (visible == 0)
+                    continue;
+
+                const BlockID* block = blocks.data() + row + x;
+
+                for (int face = 0; face < FACE_COUNT; face++)
+                {
+                    if ((visible >> face & 1) == 0)
+                        continue;
+                    const int min[3] = { x, y, z };
+                    emitQuad(min, size, face, faceTiles[(std::size_t)*block * FACE_COUNT + face], faceShade(block, light + row + x, face), out);
+                }
+            }
+        }
+}
+
+void ChunkMesher::meshGreedy(const PaddedChunk& blocks, const std::uint8_t* faces, const std::uint8_t* light, std::vector<ChunkVertex>& out) const
+{
+    // Tile + 1 of the visible face at each position of the current slice, with its corner shades from
+    // bit GREEDY_SHADE_SHIFT up, so only faces with matching corners merge. 0 where there is none.
+    std::uint64_t mask[CHUNK_AREA];
+
+    for (int face = 0; face < FACE_COUNT; face++)
+    {
+        const int normal = face / 2;
+        const int axisA = (normal + 1) % 3;
+        const int axisB = (normal + 2) % 3;
+
+        for (int slice = 0; slice < CHUNK_SIZE; slice++)
+        {
+            bool any = false;
+            for (int b = 0; b < CHUNK_SIZE; b++)
+            {
+                int position[3];
+                position[normal] = slice;
+                position[axisB] = b;
+                position[axisA] = 0;
+                const BlockID* block = blocks.data() + PaddedChunk::index(position[0], position[1], position[2]);
+                const std::uint8_t* visible = faces + position[0] + CHUNK_SIZE * (position[1] + CHUNK_SIZE * position[2]);
+                for (int a = 0; a < CHUNK_SIZE; a++, block += AXIS_STRIDES[axisA], visible += CHUNK_STRIDES[axisA])
+                {
+                    if ((*visible >> face & 1) == 0)
+                    {
+                        mask[a + b * CHUNK_SIZE] = 0;
+                        continue;
+                    }
+                    const int tile = faceTiles[(std::size_t)*block * FACE_COUNT + face];
+                    const std::uint32_t shade = faceShade(block, light + (block - blocks.data()), face);
+                    mask[a + b * CHUNK_SIZE] = (std::uint64_t)(tile + 1) | (std::uint64_t)shade << GREEDY_SHADE_SHIFT;
+                    any = true;
+                }
+            }
+            if (!any)
+                continue;
+
+            // Grow each unvisited face along axis A, then along axis B while whole rows match.
+            for (int b = 0; b < CHUNK_SIZE; b++)
+                for (int a = 0; a < CHUNK_SIZE;)
+                {
+                    const std::uint64_t key = mask[a + b * CHUNK_SIZE];
+                    if (key == 0)
+                    {
+                        a++;
+                        continue;
+                    }
+
+                    int width = 1;
+                    while (a + width < CHUNK_SIZE && mask[a + width + b * CHUNK_SIZE] == key)
+                        width++;
+
+                    int height = 1;
+                    for (; b + height < CHUNK_SIZE; height++)
+                    {
+                        const std::uint64_t* row = mask + a + (b + height) * CHUNK_SIZE;
+                        int i = 0;
+                        while (i < width && row[i] == key)
+                            i++;
+                        if (i < width)
+                            break;
+                    }
+
+                    for (int h = 0; h < height; h++)
+                        for (int w = 0; w < width; w++)
+                            mask[a + w + (b + h) * CHUNK_SIZE] = 0;
+
+                    int min[3];
+                    min[normal] = slice;
+                    min[axisA] = a;
+                    min[axisB] = b;
+                    int size[3];
+                    size[normal] = 1;
+                    size[axisA] = width;
+                    size[axisB] = height;
+                    const int tile = (int)(key & ((1 << GREEDY_SHADE_SHIFT) - 1)) - 1;
+                    emitQuad(min, size, face, (std::uint16_t)tile, (std::uint32_t)(key >> GREEDY_SHADE_SHIFT), out);
+                    a += width;
+                }
+        }
+    }
+}
+
+void ChunkMesher::meshBinaryGreedy(const PaddedChunk& blocks, const std::uint8_t* light, std::vector<ChunkVertex>& out) const
+{
+    // Kept per thread, it is too large for the stack.
+    struct Scratch
+    {
+        // Bit x of row (y, z), at y + z * PADDED_SIZE, is padded block (x, y, z).
+        std::uint64_t solid[PADDED_AREA];
+        std::uint64_t opaque[PADDED_AREA];
+
+        // Visible faces of each face direction, [face][depth][b] with bit a set for a face at (a, b),
+        // a and b running along (normal + 1) % 3 and (normal + 2) % 3.
+        std::uint64_t planes[FACE_COUNT][CHUNK_SIZE][CHUNK_SIZE];
+
+        // Tile and corner shades, tile << 24 | shade, of each visible face of the current plane at a + b * CHUNK_SIZE.
+        std::uint64_t keys[CHUNK_AREA];
+    };
+    thread_local Scratch scratch;
+
+    // Build the rows of the padded array branch-free, since air and solid blocks alternate
+    // unpredictably along terrain surfaces.
+    const BlockID* data = blocks.data();
+    const BlockID* block = data;
+    for (int row = 0; row < PADDED_AREA; row++)
+    {
+        std::uint64_t solidRow = 0;
+        std::uint64_t opaqueRow = 0;
+        for (int x = 0; x < PADDED_SIZE; x++, block++)
+        {
+            solidRow |= (std::uint64_t)(*block != BLOCK_AIR) << x;
+            opaqueRow |= (std::uint64_t)opaque[*block] << x;
+        }
+        scratch.solid[row] = solidRow;
+        scratch.opaque[row] = opaqueRow;
+    }
+
+    // A face is visible where a solid block's neighbor is not opaque, unless the neighbor is the same
+    // transparent block. Only the few faces against a transparent solid neighbor compare block IDs.
+    const std::uint64_t interior = ((std::uint64_t(1) << CHUNK_SIZE) - 1) << 1;
+    auto visible = [&](std::uint64_t solid, std::uint64_t covered, std::uint64_t neighborSolid, int row, int face) {
+        std::uint64_t faces = solid & ~covered & interior;
+        std::uint64_t transparent = faces & neighborSolid;
+        while (transparent)
+        {
+            const BlockID* current = data + row * PADDED_SIZE + countTrailingZeros(transparent);
+            if (current[NEIGHBOR_OFFSETS[face]] == *current)
+                faces &= ~(transparent & (0 - transparent));
+            transparent &= transparent - 1;
+        }
+        return faces >> 1;
+    };
+
+    // Rows of x and y faces run along y and z, so a slice of them is transposed into place. Both
+    // directions share one 64-bit transpose when they fit side by side.
+    constexpr bool SHARED_TRANSPOSE = 2 * CHUNK_SIZE <= 64;
+    std::uint64_t positive[64];
+    std::uint64_t negative[64];
+    auto transposeInto = [&](int positiveFace, int firstIndex, int secondIndex, bool byDepth) {
+        auto store = [&](int face, int i, std::uint64_t row) {
+            if (byDepth)
+                scratch.planes[face][i][secondIndex] = row;
+            else
+                scratch.planes[face][firstIndex][i] = row;
+        };
+        if (SHARED_TRANSPOSE)
+        {
+            for (int i = 0; i < CHUNK_SIZE; i++)
+                positive[i] = negative[i] | positive[i] << 32;
+            std::fill(positive + CHUNK_SIZE, positive + 64, std::uint64_t(0));
+            transpose64(positive);
+            for (int i = 0; i < CHUNK_SIZE; i++)
+            {
+                store(positiveFace + 1, i, positive[i]);
+                store(positiveFace, i, positive[32 + i]);
+            }
+            return;
+        }
+        std::fill(positive + CHUNK_SIZE, positive + 64, std::uint64_t(0));
+        std::fill(negative + CHUNK_SIZE, negative + 64, std::uint64_t(0));
+        transpose64(positive);
+        transpose64(negative);
+        for (int i = 0; i < CHUNK_SIZE; i++)
+        {
+            store(positiveFace, i, positive[i]);
+            store(positiveFace + 1, i, negative[i]);
+        }
+    };
+
+    for (int z = 0; z < CHUNK_SIZE; z++)
+    {
+        // x faces: the rows of one z slice, bits along x, become rows along y for each x.
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const int row = (y + 1) + (z + 1) * PADDED_SIZE;
+            const std::uint64_t solid = scratch.solid[row];
+            const std::uint64_t opaqueRow = scratch.opaque[row];
+            positive[y] = visible(solid, opaqueRow >> 1, solid >> 1, row, (int)BlockFace::PosX);
+            negative[y] = visible(solid, opaqueRow << 1, solid << 1, row, (int)BlockFace::NegX);
+        }
+        transposeInto((int)BlockFace::PosX, 0, z, true);
+
+        // z faces: rows along x are already in place.
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const int row = (y + 1) + (z + 1) * PADDED_SIZE;
+            const std::uint64_t solid = scratch.solid[row];
+            scratch.planes[(int)BlockFace::PosZ][z][y] =
+                visible(solid, scratch.opaque[row + PADDED_SIZE], scratch.solid[row + PADDED_SIZE], row, (int)BlockFace::PosZ);
+            scratch.planes[(int)BlockFace::NegZ][z][y] =
+                visible(solid, scratch.opaque[row - PADDED_SIZE], scratch.solid[row - PADDED_SIZE], row, (int)BlockFace::NegZ);
+        }
+    }
+
+    // y faces: the rows of one y slice, bits along x, become rows along z for each x.
+    for (int y = 0; y < CHUNK_SIZE; y++)
+    {
+        for (int z = 0; z < CHUNK_SIZE; z++)
+        {
+            const int row = (y + 1) + (z + 1) * PADDED_SIZE;
+            const std::uint64_t solid = scratch.solid[row];
+            positive[z] = visible(solid, scratch.opaque[row + 1], scratch.solid[row + 1], row, (int)BlockFace::PosY);
+            negative[z] = visible(solid, scratch.opaque[row - 1], scratch.solid[row - 1], row, (int)BlockFace::NegY);
+        }
+        transposeInto((int)BlockFace::PosY, y, 0, false);
+    }
+
+    for (int face = 0; face < FACE_COUNT; face++)
+    {
+        const int normal = face / 2;
+        const int axisA = (normal + 1) % 3;
+        const int axisB = (normal + 2) % 3;
+
+        for (int depth = 0; depth < CHUNK_SIZE; depth++)
+        {
+            std::uint64_t* rows = scratch.planes[face][depth];
+            std::uint64_t any = 0;
+            for (int b = 0; b < CHUNK_SIZE; b++)
+                any |= rows[b];
+            if (!any)
+                continue;
+
+            // Only the visible faces get a tile and shades.
+            const int planeBase = PaddedChunk::index(0, 0, 0) + depth * AXIS_STRIDES[normal];
+            for (int b = 0; b < CHUNK_SIZE; b++)
+            {
+                for (std::uint64_t bits = rows[b]; bits; bits &= bits - 1)
+                {
+                    const int a = countTrailingZeros(bits);
+                    const BlockID* current = data + planeBase + a * AXIS_STRIDES[axisA] + b * AXIS_STRIDES[axisB];
+                    const std::uint64_t tile = faceTiles[(std::size_t)*current * FACE_COUNT + face];
+                    scratch.keys[a + b * CHUNK_SIZE] = tile << 24 | faceShade(current, light + (current - data), face);
+                }
+            }
+
+            // Take the lowest face of a row and extend it along the row, then over the following rows, while
+            // the faces are set and their keys match.
+            for (int b = 0; b < CHUNK_SIZE; b++)
+            {
+                const std::uint64_t* keys = scratch.keys + b * CHUNK_SIZE;
+                while (rows[b])
+                {
+                    const int a = countTrailingZeros(rows[b]);
+                    const std::uint64_t key = keys[a];
+                    int width = 1;
+                    while ((rows[b] >> (a + width) & 1) && keys[a + width] == key)
+                        width++;
+                    const std::uint64_t run = ((std::uint64_t(1) << width) - 1) << a;
+                    rows[b] &= ~run;
+
+                    int height = 1;
+                    for (; b + height < CHUNK_SIZE && (rows[b + height] & run) == run; height++)
+                    {
+                        const std::uint64_t* next = keys + height * CHUNK_SIZE + a;
+                        int i = 0;
+                        while (i < width && next[i] == key)
+                            i++;
+                        if (i < width)
+                            break;
+                        rows[b + height] &= ~run;
+                    }
+
+                    int min[3];
+                    min[normal] = depth;
+                    min[axisA] = a;
+                    min[axisB] = b;
+                    int size[3];
+                    size[normal] = 1;
+                    size[axisA] = width;
+                    size[axisB] = height;
+                    emitQuad(min, size, face, (std::uint16_t)(key >> 24), (std::uint32_t)key & 0xFFFFFF, out);
+                }
+            }
+        }
+    }
+}
+
+std::uint32_t ChunkMesher::faceShade(const BlockID* block, const std::uint8_t* light, int face) const
+{
+    // Each corner is darkened by the opaque blocks among the three that touch it in the layer the face looks
+    // into, and lit by the average of the blocks in that layer the light can reach the corner through.
+    const int front = NEIGHBOR_OFFSETS[face];
+    const int uStride = AXIS_STRIDES[FACE_U_AXIS[face]];
+    const int vStride = AXIS_STRIDES[FACE_V_AXIS[face]];
+
+    std::uint32_t shade = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        const int u = FACE_CORNERS[face][i][FACE_U_AXIS[face]] ? uStride : -uStride;
+        const int v = FACE_CORNERS[face][i][FACE_V_AXIS[face]] ? vStride : -vStride;
+        const int side1 = opaque[block[front + u]];
+        const int side2 = opaque[block[front + v]];
+        const int corner = opaque[block[front + u + v]];
+
+        // Two opaque sides close the corner off completely, whatever the diagonal block is.
+        const bool closed = side1 && side2;
+        const int ao = closed ? 0 : 3 - side1 - side2 - corner;
+
+        int sum = light[front];
+        int samples = 1;
+        if (!side1)
+        {
+            sum += light[front + u];
+            samples++;
+        }
+        if (!side2)
+        {
+            sum += light[front + v];
+            samples++;
+        }
+        if (!corner && !closed)
+        {
+            sum += light[front + u + v];
+            samples++;
+        }
+        const int level = (sum + samples / 2) / samples;
+
+        shade |= (std::uint32_t)(ao | level << 2) << (6 * i);
+    }
+    return shade;
+}
+
+void ChunkMesher::emitQuad(const int min[3], const int size[3], int face, std::uint16_t tile, std::uint32_t shade, std::vector<ChunkVertex>& out)
+{
+    const int uSize = size[FACE_U_AXIS[face]];
+    const int vSize = size[FACE_V_AXIS[face]];
+
+    ChunkVertex corners[4];
+    for (int i = 0; i < 4; i++)
+    {
+        corners[i] = packChunkVertex(
+            min[0] + FACE_CORNERS[face][i][0] * size[0],
+            min[1] + FACE_CORNERS[face][i][1] * size[1],
+            min[2] + FACE_CORNERS[face][i][2] * size[2],
+            CORNER_UVS[i][0] * uSize, CORNER_UVS[i][1] * vSize,
+            tile, face, shade >> (6 * i) & 3, shade >> (6 * i + 2) & 15);
+    }
+
+    // The index pattern splits the quad along corners 0-2. Split along the brighter diagonal instead,
+    // by starting at corner 1, so a single dark corner shades one triangle rather than a streak across both.
+    // Occlusion weighs more than light, matching the fragment shader where one level of either is
+    // roughly a fifth and a fifteenth of full brightness.
+    int brightness[4];
+    for (int i = 0; i < 4; i++)
+        brightness[i] = (int)(shade >> (6 * i) & 3) * 5 + (int)(shade >> (6 * i + 2) & 15);
+    if (brightness[0] + brightness[2] < brightness[1] + brightness[3])
+    {
+        out.insert(out.end(), { corners[1], corners[2], corners[3], corners[0] });
+        return;
+    }
+
+    out.insert(out.end(), corners, corners + 4);
+}
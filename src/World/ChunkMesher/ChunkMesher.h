@@ -0,0 +1,228 @@
+#ifndef CHUNK_MESHER_H
+#define CHUNK_MESHER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../Block/Block.h"
+#include "../BlockRegistry/BlockRegistry.h"
+#include "../FaceClassifier/FaceClassifier.h"
+#include "../PaddedChunk/PaddedChunk.h"
+#include "../PaddedLight/PaddedLight.h"
+
+// How a chunk's visible faces are turned into quads.
+enum class MeshingMode
+{
+    // One quad per visible block face.
+    Culled,
+
+    // Adjacent coplanar faces with the same tile and corner shading are merged into larger quads.
+    Greedy,
+
+    // Same quads as Greedy, found with 64-bit row masks instead of per-block loops.
+    BinaryGreedy
+};
+
+// Indices of the two triangles of a quad, offset by four for each quad of a mesh.
+constexpr std::uint32_t QUAD_INDEX_PATTERN[6] = { 0, 1, 2, 2, 3, 0 };
+
+// What the mesher hands to the renderer for each chunk.
+enum class ChunkMeshFormat
+{
+    // Four ChunkVertex per quad, quads built according to the MeshingMode.
+    Vertices,
+
+    // One packed word per visible face, expanded into a quad by the face vertex shader.
+    Faces,
+
+    // Smooth terrain from the SurfaceNetsMesher, with shared vertices and its own index buffer.
+    SurfaceNets
+};
+
+static_assert(CHUNK_SIZE < 64, "chunk vertices store positions in 6 bits");
+
+/*
+ * Vertex layout of chunk meshes: two 32-bit words, unpacked by the block shader.
+ *
+ * position: x, y and z relative to the chunk's origin, then u and v, 6 bits each
+ *           from bit 0. u and v are the position on the face in tiles; the shader
+ *           repeats the tile across quads larger than one block.
+ * attributes: atlas tile in bits 0-15, face (a BlockFace) in bits 16-18, ambient
+ *             occlusion in bits 19-20 (3 is unoccluded) and light in bits 21-24.
+ */
+struct ChunkVertex
+{
+    std::uint32_t position;
+    std::uint32_t attributes;
+};
+
+constexpr int VERTEX_AO_SHIFT = 19;
+constexpr int VERTEX_LIGHT_SHIFT = 21;
+constexpr std::uint32_t VERTEX_AO_MAX = 3;
+constexpr std::uint32_t VERTEX_LIGHT_MAX = 15;
+
+/**
+ * Packs a chunk vertex.
+ *
+ * @param x Local x-position, in [0, CHUNK_SIZE].
+ * @param y Local y-position, in [0, CHUNK_SIZE].
+ * @param z Local z-position, in [0, CHUNK_SIZE].
+ * @param u Position along the tile's u axis, in tiles.
+ * @param v Position along the tile's v axis, in tiles.
+ * @param tile The atlas tile.
+ * @param face The face direction.
+ * @param ao Ambient occlusion, in [0, VERTEX_AO_MAX].
+ * @param light Light level, in [0, VERTEX_LIGHT_MAX].
+ * @return The packed vertex.
+ */
+inline ChunkVertex packChunkVertex(int x, int y, int z, int u, int v, std::uint16_t tile, int face,
+                                   std::uint32_t ao = VERTEX_AO_MAX, std::uint32_t light = VERTEX_LIGHT_MAX)
+{
+    return ChunkVertex{
+        (std::uint32_t)x | (std::uint32_t)y << 6 | (std::uint32_t)z << 12 | (std::uint32_t)u << 18 | (std::uint32_t)v << 24,
+        (std::uint32_t)tile | (std::uint32_t)face << 16 | ao << VERTEX_AO_SHIFT | light << VERTEX_LIGHT_SHIFT
+    };
+}
+
+/*
+ * Word per visible face of the Faces format: x, y and z of the block at 6 bits
+ * each from bit 0, the face (a BlockFace) in bits 18-20 and the atlas tile in
+ * bits 21-31. The shader reads the words from a buffer texture and builds the
+ * quad's corners from gl_VertexID, so a face costs 4 bytes instead of four
+ * vertices. A word has no room for a quad size, so faces are never merged.
+ */
+constexpr int CHUNK_FACE_TILE_SHIFT = 21;
+constexpr std::size_t CHUNK_FACE_MAX_TILES = std::size_t(1) << (32 - CHUNK_FACE_TILE_SHIFT);
+
+/**
+ * Packs a face of the Faces format.
+ *
+ * @param x Local x-position of the block, in [0, CHUNK_SIZE).
+ * @param y Local y-position of the block, in [0, CHUNK_SIZE).
+ * @param z Local z-position of the block, in [0, CHUNK_SIZE).
+ * @param face The face direction.
+ * @param tile The atlas tile, below CHUNK_FACE_MAX_TILES.
+ * @return The packed face.
+ */
+inline std::uint32_t packChunkFace(int x, int y, int z, int face, std::uint16_t tile)
+{
+    return (std::uint32_t)x | (std::uint32_t)y << 6 | (std::uint32_t)z << 12 | (std::uint32_t)face << 18
+        | (std::uint32_t)tile << CHUNK_FACE_TILE_SHIFT;
+}
+
+/*
+ * Builds the vertices of a chunk, emitting only the faces of blocks that
+ * border a non-opaque block. Faces between two blocks of the same type are
+ * also skipped, so runs of a transparent block only show their outer faces.
+ * In greedy mode each slice of faces is merged into maximal rectangles of
+ * matching faces, which turns flat terrain into a handful of quads.
+ *
+ * Binary greedy mode builds the same quads from bitmasks: one 64-bit word per
+ * x-row of the padded chunk gives the visible faces of the row with a shift
+ * and an AND-NOT, x and y faces are transposed into rows of their own plane,
+ * and rectangles are merged along rows with bit scans, comparing the tile and
+ * shades of each face only where a face is visible. Building the row words
+ * still looks up every block, so it meshes slower than culled mode and only
+ * pays off through its smaller meshes.
+ *
+ * Every vertex gets classic voxel ambient occlusion, baked from the three
+ * blocks touching its corner in front of the face, so it costs nothing per
+ * frame. Light is smoothed the same way: sky and block light are propagated
+ * through the padded chunk for each mesh, and each corner gets the average
+ * level of the blocks in front of the face that the light can reach it through.
+ * Faces in the Faces format have no room for either and stay unshaded.
+ */
+class ChunkMesher
+{
+public:
+    /**
+     * Constructor caches the opacity, emission and face tiles of every block. Blocks registered
+     * afterwards are not picked up.
+     *
+     * @param mode How visible faces are turned into quads. Culled is the default since it meshes
+     *             fastest once faces are shaded, at the cost of more vertices than the greedy modes.
+     */
+    explicit ChunkMesher(MeshingMode mode = MeshingMode::Culled);
+
+    /**
+     * Meshes a chunk. Safe to call from several threads at once.
+     *
+     * @param blocks The chunk and its apron.
+     * @param out Receives the four corners of each quad, counter-clockwise, to be drawn
+     *            with the shared QUAD_INDEX_PATTERN; cleared first.
+     */
+    void mesh(const PaddedChunk& blocks, std::vector<ChunkVertex>& out) const;
+
+    /**
+     * Lists the visible faces of a chunk in the Faces format, ignoring the meshing mode.
+     * Safe to call from several threads at once.
+     *
+     * @param blocks The chunk and its apron.
+     * @param out Receives one packed word per visible face; cleared first. Faces whose tile is
+     *            not below CHUNK_FACE_MAX_TILES show tile 0 instead.
+     */
+    void meshFaces(const PaddedChunk& blocks, std::vector<std::uint32_t>& out) const;
+
+    // Returns the meshing mode.
+    MeshingMode getMode() const { return mode; }
+
+private:
+    MeshingMode mode;
+
+    // Finds the visible faces for the culled and greedy modes, with SIMD where available.
+    FaceClassifier classifier;
+
+    // Opacity of every block ID, from the block registry.
+    std::vector<std::uint8_t> opaque;
+
+    // Light emitted by every block ID, from the block registry.
+    std::vector<std::uint8_t> emission;
+
+    // Atlas tile of face f of block b at b * FACE_COUNT + f.
+    std::vector<std::uint16_t> faceTiles;
+
+    // One more than the highest tile any block uses.
+    std::size_t tileCount = 0;
+
+    // Runs the face classifier into this thread's buffer and returns the face masks.
+    const std::uint8_t* classify(const PaddedChunk& blocks) const;
+
+    /**
+     * Returns the ambient occlusion and smooth light of a visible face's corners, from the blocks
+     * next to each corner in front of the face.
+     *
+     * @param block The block in the padded array.
+     * @param light The block's light level, at the same padded index in the chunk's light volume.
+     * @param face The face direction.
+     * @return 6 bits per corner in FACE_CORNERS order: the ambient occlusion in the low 2, from 0
+     *         (fully occluded) to VERTEX_AO_MAX, and the light level above it, up to VERTEX_LIGHT_MAX.
+     */
+    std::uint32_t faceShade(const BlockID* block, const std::uint8_t* light, int face) const;
+
+    // Meshes with one quad per visible face, given the face masks from the classifier and the light volume.
+    void meshCulled(const PaddedChunk& blocks, const std::uint8_t* faces, const std::uint8_t* light,
+                    std::vector<ChunkVertex>& out) const;
+
+    // Meshes by merging each slice of visible faces into rectangles, given the face masks from the classifier
+    // and the light volume.
+    void meshGreedy(const PaddedChunk& blocks, const std::uint8_t* faces, const std::uint8_t* light,
+                    std::vector<ChunkVertex>& out) const;
+
+    // Meshes like meshGreedy, working on 64-bit masks of faces.
+    void meshBinaryGreedy(const PaddedChunk& blocks, const std::uint8_t* light, std::vector<ChunkVertex>& out) const;
+
+    /**
+     * Appends the four corners of a quad covering a rectangle of faces.
+     *
+     * @param min Local position of the rectangle's minimum block.
+     * @param size Size of the rectangle in blocks along each axis, 1 along the face's normal.
+     * @param face The face direction.
+     * @param tile The face's atlas tile.
+     * @param shade Ambient occlusion and light of the quad's corners, as returned by faceShade().
+     * @param out The vertex list to append to.
+     */
+    static void emitQuad(const int min[3], const int size[3], int face, std::uint16_t tile, std::uint32_t shade,
+                         std::vector<ChunkVertex>& out);
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef CHUNK_NEIGHBORHOOD_H
+#define CHUNK_NEIGHBORHOOD_H
+
+#include <array>
+
+#include "../Chunk/Chunk.h"
+#include "../Heightmap/Heightmap.h"
+
+/*
+ * Snapshots of a chunk and the 26 chunks around it, taken together so that
+ * background meshing and lighting see one consistent version of every block
+ * they read. Unloaded neighbors are represented by unloaded (all-air) snapshots.
+ */
+struct ChunkNeighborhood
+{
+    // Snapshots indexed by (dx + 1) + 3 * ((dy + 1) + 3 * (dz + 1)).
+    std::array<ChunkSnapshot, 27> chunks;
+
+    // World y-position of the highest non-air block of each column of the center chunk and a one
+    // block border around it, indexed by (x + 1) + (z + 1) * (CHUNK_SIZE + 2), or HEIGHT_NONE.
+    std::array<int, (CHUNK_SIZE + 2) * (CHUNK_SIZE + 2)> surface{};
+
+    // Returns the center chunk.
+    const ChunkSnapshot& center() const { return chunks[13]; }
+
+    // Returns the chunk at the given offset from the center, each offset in [-1, 1].
+    const ChunkSnapshot& at(int dx, int dy, int dz) const
+    {
+        return chunks[(dx + 1) + 3 * ((dy + 1) + 3 * (dz + 1))];
+    }
+
+    /**
+     * Returns a block relative to the center chunk.
+     *
+     * @param x Position relative to the center chunk's origin, in [-CHUNK_SIZE, 2 * CHUNK_SIZE).
+     * @param y Position relative to the center chunk's origin, in [-CHUNK_SIZE, 2 * CHUNK_SIZE).
+     * @param z Position relative to the center chunk's origin, in [-CHUNK_SIZE, 2 * CHUNK_SIZE).
+     * @return The ID of the block.
+     */
+    BlockID getBlock(int x, int y, int z) const
+    {
+        const int dx = x < 0 ? -1 : x >= CHUNK_SIZE ? 1 : 0;
+        const int dy = y < 0 ? -1 : y >= CHUNK_SIZE ? 1 : 0;
+        const int dz = z < 0 ? -1 : z >= CHUNK_SIZE ? 1 : 0;
+        return at(dx, dy, dz).getBlock(x - dx * CHUNK_SIZE, y - dy * CHUNK_SIZE, z - dz * CHUNK_SIZE);
+    }
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include <iostream>
+
+#include "ChunkPools.h"
+
+
+#ifdef VOXEL_HUGE_PAGES
+static const bool USE_HUGE_PAGES = true;
+#else
+static const bool USE_HUGE_PAGES = false;
+#endif
+
+// Creates a pool that is intentionally never destroyed.
+static SlabPool& makePool(std::size_t slotSize)
+{
+    return *new SlabPool(slotSize, USE_HUGE_PAGES);
+}
+
+SlabPool& ChunkPools::sectionEntries(int bitsPerEntry)
+{
+    static SlabPool* pools[5] = {
+        &makePool(SECTION_VOLUME * 1 / 8),
+        &makePool(SECTION_VOLUME * 2 / 8),
+        &makePool(SECTION_VOLUME * 4 / 8),
+        &makePool(SECTION_VOLUME * 8 / 8),
+        &makePool(SECTION_VOLUME * 16 / 8)
+    };
+    const int slot = bitsPerEntry == 1 ? 0 : bitsPerEntry == 2 ? 1 : bitsPerEntry == 4 ? 2 : bitsPerEntry == 8 ? 3 : 4;
+    return *pools[slot];
+}
+
+SlabPool& ChunkPools::meshScratch()
+{
+    static SlabPool& pool = makePool(MESH_SCRATCH_BYTES);
+    return pool;
+}
+
+SlabPool& ChunkPools::meshLight()
+{
+    static SlabPool& pool = makePool(MESH_LIGHT_BYTES);
+    return pool;
+}
+
+static void printPool(const char* name, const SlabPool& pool)
+{
+    const SlabPoolStats stats = pool.getStats();
+    std::cout << "  " << name << ": " << stats.slotsInUse << " / " << stats.slabCount * stats.slotsPerSlab
+        << " slots of " << stats.slotSize << " bytes in use (" << stats.occupancy() * 100.0 << "%), peak "
+        << stats.peakSlotsInUse << ", " << stats.totalAllocations << " allocations, " << stats.slabCount
+        << " slabs (" << stats.hugePageSlabs << " on huge pages)" << std::endl;
+}
+
+void ChunkPools::printStats()
+{
+    std::cout << "Chunk memory pools" << std::endl;
+    printPool("section entries 1 bit", sectionEntries(1));
+    printPool("section entries 2 bit", sectionEntries(2));
+    printPool("section entries 4 bit", sectionEntries(4));
+    printPool("section entries 8 bit", sectionEntries(8));
+    printPool("section entries 16 bit", sectionEntries(16));
+    printPool("mesh scratch", meshScratch());
+    printPool("mesh light", meshLight());
+}
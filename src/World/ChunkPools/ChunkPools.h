@@ -0,0 +1,42 @@
+#ifndef CHUNK_POOLS_H
+#define CHUNK_POOLS_H
+
+#include <cstddef>
+
+#include "../../Core/SlabPool/SlabPool.h"
+#include "../Block/Block.h"
+#include "../Chunk/Chunk.h"
+
+// Bytes in a mesh scratch buffer: a chunk's blocks plus a one block apron on every side.
+constexpr std::size_t MESH_SCRATCH_BYTES = (std::size_t)(CHUNK_SIZE + 2) * (CHUNK_SIZE + 2) * (CHUNK_SIZE + 2) * sizeof(BlockID);
+
+// Bytes in a mesh light buffer: one light level per block of a padded chunk.
+constexpr std::size_t MESH_LIGHT_BYTES = (std::size_t)(CHUNK_SIZE + 2) * (CHUNK_SIZE + 2) * (CHUNK_SIZE + 2);
+
+/*
+ * The slab pools shared by all chunks. Slabs use huge pages when the engine is
+ * built with VOXEL_HUGE_PAGES. The pools live until the process exits so that
+ * chunk data released during static destruction is still valid to free.
+ */
+class ChunkPools
+{
+public:
+    /**
+     * Returns the pool for packed section entries of the given width.
+     *
+     * @param bitsPerEntry One of 1, 2, 4, 8 or 16.
+     * @return The pool.
+     */
+    static SlabPool& sectionEntries(int bitsPerEntry);
+
+    // Returns the pool for mesher scratch buffers of MESH_SCRATCH_BYTES.
+    static SlabPool& meshScratch();
+
+    // Returns the pool for the light levels mesh jobs compute, of MESH_LIGHT_BYTES.
+    static SlabPool& meshLight();
+
+    // Prints the occupancy of every pool to stdout.
+    static void printStats();
+};
+
+#endif
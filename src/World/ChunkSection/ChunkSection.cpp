@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "ChunkSection.h"
+#include "../ChunkPools/ChunkPools.h"
+
+
+// Number of 64-bit words needed to pack a full section with the given entry width.
+static std::size_t wordsFor(int bitsPerEntry)
+{
+    return (std::size_t)SECTION_VOLUME * bitsPerEntry / 64;
+}
+
+ChunkSection::ChunkSection(BlockID block)
+    : uniformBlock(block)
+{
+}
+
+ChunkSection::ChunkSection(const ChunkSection& other)
+    : uniformBlock(other.uniformBlock), palette(other.palette), paletteCounts(other.paletteCounts),
+      bitsPerEntry(other.bitsPerEntry)
+{
+    if (other.entries)
+    {
+        entries = PoolBuffer<std::uint64_t>(ChunkPools::sectionEntries(bitsPerEntry));
+        std::memcpy(entries.get(), other.entries.get(), wordsFor(bitsPerEntry) * sizeof(std::uint64_t));
+    }
+}
+
+ChunkSection& ChunkSection::operator=(const ChunkSection& other)
+{
+    if (this != &other)
+        *this = ChunkSection(other);
+    return *this;
+}
+
+void ChunkSection::setBlock(int x, int y, int z, BlockID block)
+{
+    if (bitsPerEntry == 0)
+    {
+        if (block == uniformBlock)
+            return;
+        expand();
+    }
+
+    const int i = index(x, y, z);
+    const std::uint32_t previous = readEntry(i);
+    if (palette[previous] == block)
+        return;
+
+    const std::uint32_t next = paletteIndexOf(block);
+    writeEntry(i, next);
+    paletteCounts[previous]--;
+    if (++paletteCounts[next] == SECTION_VOLUME)
+        fill(block);
+}
+
+void ChunkSection::fill(BlockID block)
+{
+    uniformBlock = block;
+    bitsPerEntry = 0;
+    std::vector<BlockID>().swap(palette);
+    std::vector<std::uint16_t>().swap(paletteCounts);
+    entries.reset();
+}
+
+bool ChunkSection::contains(BlockID block) const
+{
+    if (bitsPerEntry == 0)
+        return uniformBlock == block;
+    for (std::size_t i = 0; i < palette.size(); i++)
+    {
+        if (palette[i] == block && paletteCounts[i] > 0)
+            return true;
+    }
+    return false;
+}
+
+bool ChunkSection::fillBox(glm::ivec3 min, glm::ivec3 max, BlockID block)
+{
+    if (coversSection(min, max))
+    {
+        const bool changed = bitsPerEntry != 0 || uniformBlock != block;
+        fill(block);
+        return changed;
+    }
+    return fillWhere(min, max, block, [](int, int, int) { return true; });
+}
+
+bool ChunkSection::replaceInBox(glm::ivec3 min, glm::ivec3 max, BlockID from, BlockID to)
+{
+    if (from == to)
+        return false;
+
+    if (bitsPerEntry == 0)
+        return uniformBlock == from && fillBox(min, max, to);
+
+    std::uint32_t fromIndex = (std::uint32_t)palette.size();
+    for (std::size_t i = 0; i < palette.size(); i++)
+    {
+        if (palette[i] == from && paletteCounts[i] > 0)
+            fromIndex = (std::uint32_t)i;
+    }
+    if (fromIndex == palette.size())
+        return false;
+
+    const std::uint32_t toIndex = paletteIndexOf(to);
+    bool changed = false;
+    for (int z = min.z; z < max.z; z++)
+        for (int y = min.y; y < max.y; y++)
+            for (int x = min.x; x < max.x; x++)
+            {
+                const int i = index(x, y, z);
+                if (readEntry(i) != fromIndex)
+                    continue;
+                writeEntry(i, toIndex);
+                paletteCounts[fromIndex]--;
+                paletteCounts[toIndex]++;
+                changed = true;
+            }
+
+    collapseIfUniform();
+    return changed;
+}
+
+void ChunkSection::assign(const BlockID* blocks)
+{
+    // Counts are accumulated per run of equal blocks, which also skips the palette search inside a run.
+    std::vector<BlockID> newPalette = { blocks[0] };
+    std::vector<std::uint16_t> newCounts = { 0 };
+    BlockID current = blocks[0];
+    std::uint32_t last = 0;
+    int runStart = 0;
+    for (int n = 1; n < SECTION_VOLUME; n++)
+    {
+        if (blocks[n] == current)
+            continue;
+
+        newCounts[last] += (std::uint16_t)(n - runStart);
+        runStart = n;
+        current = blocks[n];
+        last = 0;
+        while (last < newPalette.size() && newPalette[last] != current)
+            last++;
+        if (last == newPalette.size())
+        {
+            newPalette.push_back(current);
+            newCounts.push_back(0);
+        }
+    }
+    newCounts[last] += (std::uint16_t)(SECTION_VOLUME - runStart);
+
+    if (newPalette.size() == 1)
+    {
+        fill(current);
+        return;
+    }
+
+    int bits = 1;
+    while (((std::size_t)1 << bits) < newPalette.size())
+        bits *= 2;
+
+    palette = std::move(newPalette);
+    paletteCounts = std::move(newCounts);
+    bitsPerEntry = bits;
+    entries = allocateEntries(bits);
+
+    // Entries are packed into a register and flushed whenever the layout moves on to
+    // another word; the buffer starts zeroed, so flushing is a single OR.
+    const int perWordShift = 6 - log2Bits();
+    const int laneMask = (1 << perWordShift) - 1;
+    std::uint64_t* words = entries.get();
+    std::uint64_t word = 0;
+    int wordIndex = 0;
+    current = palette[0];
+    last = 0;
+    for (int z = 0; z < SECTION_SIZE; z++)
+        for (int y = 0; y < SECTION_SIZE; y++)
+            for (int x = 0; x < SECTION_SIZE; x++, blocks++)
+            {
+                if (*blocks != current)
+                {
+                    current = *blocks;
+                    last = 0;
+                    while (palette[last] != current)
+                        last++;
+                }
+                const int i = index(x, y, z);
+                if ((i >> perWordShift) != wordIndex)
+                {
+                    words[wordIndex] |= word;
+                    wordIndex = i >> perWordShift;
+                    word = 0;
+                }
+                word |= (std::uint64_t)last << ((i & laneMask) * bits);
+            }
+    words[wordIndex] |= word;
+}
+
+void ChunkSection::copyRow(int y, int z, BlockID* out) const
+{
+    if (bitsPerEntry == 0)
+    {
+        std::fill_n(out, SECTION_SIZE, uniformBlock);
+        return;
+    }
+
+    if (!std::is_same<BlockLayout<SECTION_SIZE>, LinearLayout<SECTION_SIZE>>::value)
+    {
+        for (int x = 0; x < SECTION_SIZE; x++)
+            out[x] = palette[readEntry(index(x, y, z))];
+        return;
+    }
+
+    // Rows are contiguous in the linear layout, so they can be unpacked with fixed shifts.
+    const int start = index(0, y, z);
+    switch (bitsPerEntry)
+    {
+    case 1: decodeRow<1>(start, out); break;
+    case 2: decodeRow<2>(start, out); break;
+    case 4: decodeRow<4>(start, out); break;
+    case 8: decodeRow<8>(start, out); break;
+    default: decodeRow<16>(start, out); break;
+    }
+}
+
+std::size_t ChunkSection::memoryUsage() const
+{
+    return palette.capacity() * sizeof(BlockID)
+        + paletteCounts.capacity() * sizeof(std::uint16_t)
+        + entries.bytes();
+}
+
+void ChunkSection::writeEntry(int i, std::uint32_t value)
+{
+    const int perWordShift = 6 - log2Bits();
+    std::uint64_t& word = entries[i >> perWordShift];
+    const int shift = (i & ((1 << perWordShift) - 1)) * bitsPerEntry;
+    word = (word & ~(entryMask() << shift)) | ((std::uint64_t)value << shift);
+}
+
+std::uint32_t ChunkSection::paletteIndexOf(BlockID block)
+{
+    std::size_t freeSlot = palette.size();
+    for (std::size_t i = 0; i < palette.size(); i++)
+    {
+        if (palette[i] == block)
+            return (std::uint32_t)i;
+        if (paletteCounts[i] == 0 && freeSlot == palette.size())
+            freeSlot = i;
+    }
+
+    if (freeSlot < palette.size())
+    {
+        palette[freeSlot] = block;
+        return (std::uint32_t)freeSlot;
+    }
+
+    palette.push_back(block);
+    paletteCounts.push_back(0);
+    if (palette.size() > ((std::size_t)1 << bitsPerEntry))
+        resize(bitsPerEntry * 2);
+    return (std::uint32_t)(palette.size() - 1);
+}
+
+template <int Bits>
+void ChunkSection::decodeRow(int i, BlockID* out) const
+{
+    constexpr int PER_WORD = 64 / Bits;
+    constexpr std::uint64_t MASK = (std::uint64_t(1) << Bits) - 1;
+
+    // Unpack into a small index buffer first; this loop has no data-dependent loads and vectorizes.
+    std::uint16_t indices[SECTION_SIZE];
+    const std::uint64_t* words = entries.get();
+    for (int k = 0; k < SECTION_SIZE; k++)
+    {
+        const int e = i + k;
+        indices[k] = (std::uint16_t)((words[e / PER_WORD] >> ((e % PER_WORD) * Bits)) & MASK);
+    }
+
+    const BlockID* table = palette.data();
+    for (int k = 0; k < SECTION_SIZE; k++)
+        out[k] = table[indices[k]];
+}
+
+void ChunkSection::resize(int newBitsPerEntry)
+{
+    std::vector<std::uint32_t> unpacked(SECTION_VOLUME);
+    for (int i = 0; i < SECTION_VOLUME; i++)
+        unpacked[i] = readEntry(i);
+
+    bitsPerEntry = newBitsPerEntry;
+    entries = allocateEntries(newBitsPerEntry);
+    for (int i = 0; i < SECTION_VOLUME; i++)
+        writeEntry(i, unpacked[i]);
+}
+
+void ChunkSection::expand()
+{
+    bitsPerEntry = 1;
+    palette = { uniformBlock };
+    paletteCounts = { (std::uint16_t)SECTION_VOLUME };
+    entries = allocateEntries(1);
+}
+
+PoolBuffer<std::uint64_t> ChunkSection::allocateEntries(int bitsPerEntry)
+{
+    PoolBuffer<std::uint64_t> buffer(ChunkPools::sectionEntries(bitsPerEntry));
+    std::memset(buffer.get(), 0, wordsFor(bitsPerEntry) * sizeof(std::uint64_t));
+    return buffer;
+}
+
+void ChunkSection::collapseIfUniform()
+{
+    for (std::size_t i = 0; i < palette.size(); i++)
+    {
+        if (paletteCounts[i] == SECTION_VOLUME)
+        {
+            fill(palette[i]);
+            return;
+        }
+    }
+}
@@ -0,0 +1,258 @@
+#ifndef CHUNK_SECTION_H
+#define CHUNK_SECTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <../include/glm/glm.hpp>
+
+#include "../../Core/SlabPool/SlabPool.h"
+#include "../Block/Block.h"
+#include "../BlockLayout/BlockLayout.h"
+
+// Number of blocks along each axis of a chunk section.
+constexpr int SECTION_SIZE = 16;
+constexpr int SECTION_AREA = SECTION_SIZE * SECTION_SIZE;
+constexpr int SECTION_VOLUME = SECTION_AREA * SECTION_SIZE;
+
+/*
+ * A cube of SECTION_SIZE^3 blocks stored as indices into a palette of the
+ * block IDs that appear in it. Indices are bit-packed into 64-bit words
+ * using 1, 2, 4, 8 or 16 bits per entry, and the width doubles whenever the
+ * palette outgrows it.
+ *
+ * A section holding a single block type is uniform: it stores that one
+ * block ID and owns no palette or entry array at all. Entry arrays come from
+ * the per-width ChunkPools so sections are recycled instead of hitting the heap.
+ */
+class ChunkSection
+{
+public:
+    /**
+     * Constructor creates a uniform section.
+     *
+     * @param block The block filling the section.
+     */
+    explicit ChunkSection(BlockID block = BLOCK_AIR);
+
+    ChunkSection(const ChunkSection& other);
+    ChunkSection& operator=(const ChunkSection& other);
+    ChunkSection(ChunkSection&& other) noexcept = default;
+    ChunkSection& operator=(ChunkSection&& other) noexcept = default;
+
+    /**
+     * Returns the block at the given local position.
+     *
+     * @param x Local x-position, in [0, SECTION_SIZE).
+     * @param y Local y-position, in [0, SECTION_SIZE).
+     * @param z Local z-position, in [0, SECTION_SIZE).
+     * @return The ID of the block.
+     */
+    BlockID getBlock(int x, int y, int z) const
+    {
+        if (bitsPerEntry == 0)
+            return uniformBlock;
+        return palette[readEntry(index(x, y, z))];
+    }
+
+    /**
+     * Sets the block at the given local position, growing the palette if needed.
+     * The section collapses back to uniform once a single block type remains.
+     *
+     * @param x Local x-position, in [0, SECTION_SIZE).
+     * @param y Local y-position, in [0, SECTION_SIZE).
+     * @param z Local z-position, in [0, SECTION_SIZE).
+     * @param block The ID of the new block.
+     */
+    void setBlock(int x, int y, int z, BlockID block);
+
+    // Sets every block in the section, making it uniform.
+    void fill(BlockID block);
+
+    /**
+     * Sets every block in a box. Resolves the block's palette slot once and writes the
+     * packed entries directly; covering the whole section makes it uniform.
+     *
+     * @param min Minimum local corner of the box (inclusive).
+     * @param max Maximum local corner of the box (exclusive).
+     * @param block The ID of the new block.
+     * @return True if any block changed.
+     */
+    bool fillBox(glm::ivec3 min, glm::ivec3 max, BlockID block);
+
+    /**
+     * Replaces one block type with another inside a box. Returns immediately when the
+     * section does not contain the block being replaced.
+     *
+     * @param min Minimum local corner of the box (inclusive).
+     * @param max Maximum local corner of the box (exclusive).
+     * @param from The block to replace.
+     * @param to The block to replace it with.
+     * @return True if any block changed.
+     */
+    bool replaceInBox(glm::ivec3 min, glm::ivec3 max, BlockID from, BlockID to);
+
+    /**
+     * Sets the blocks inside a box for which inside(x, y, z) returns true, resolving the
+     * block's palette slot once for the whole call.
+     *
+     * @param min Minimum local corner of the box (inclusive).
+     * @param max Maximum local corner of the box (exclusive).
+     * @param block The ID of the new block.
+     * @param inside Called with local coordinates to select the blocks to set.
+     * @return True if any block changed.
+     */
+    template <typename Predicate>
+    bool fillWhere(glm::ivec3 min, glm::ivec3 max, BlockID block, Predicate&& inside)
+    {
+        if (bitsPerEntry == 0)
+        {
+            if (uniformBlock == block)
+                return false;
+            expand();
+        }
+
+        const std::uint32_t value = paletteIndexOf(block);
+        bool changed = false;
+        for (int z = min.z; z < max.z; z++)
+            for (int y = min.y; y < max.y; y++)
+                for (int x = min.x; x < max.x; x++)
+                {
+                    if (!inside(x, y, z))
+                        continue;
+                    const int i = index(x, y, z);
+                    const std::uint32_t previous = readEntry(i);
+                    if (previous == value)
+                        continue;
+                    writeEntry(i, value);
+                    paletteCounts[previous]--;
+                    paletteCounts[value]++;
+                    changed = true;
+                }
+
+        collapseIfUniform();
+        return changed;
+    }
+
+    /**
+     * Replaces every block in the section in one pass, rebuilding the palette and packing
+     * the entries at the narrowest width that fits. A single block type makes the section uniform.
+     *
+     * @param blocks SECTION_VOLUME block IDs in row order, with block (x, y, z) at x + SECTION_SIZE * (y + SECTION_SIZE * z).
+     */
+    void assign(const BlockID* blocks);
+
+    /**
+     * Copies every block in the section into a contiguous buffer.
+     *
+     * @param out Receives SECTION_VOLUME block IDs in the row order used by assign.
+     */
+    void copyTo(BlockID* out) const
+    {
+        for (int z = 0; z < SECTION_SIZE; z++)
+            for (int y = 0; y < SECTION_SIZE; y++)
+                copyRow(y, z, out + SECTION_SIZE * (y + SECTION_SIZE * z));
+    }
+
+    /**
+     * Copies the SECTION_SIZE blocks of one x-row into a contiguous buffer.
+     *
+     * @param y Local y-position of the row.
+     * @param z Local z-position of the row.
+     * @param out Receives SECTION_SIZE block IDs, ordered by x.
+     */
+    void copyRow(int y, int z, BlockID* out) const;
+
+    // Returns true if the whole section is a single block type. Passes can skip such sections with this one check.
+    bool isUniform() const { return bitsPerEntry == 0; }
+
+    // Returns the block filling a uniform section, only meaningful when isUniform() is true.
+    BlockID getUniformBlock() const { return uniformBlock; }
+
+    // Returns true if at least one block in the section is the given block.
+    bool contains(BlockID block) const;
+
+    // Returns true if every block in the section is air.
+    bool isEmpty() const { return bitsPerEntry == 0 && uniformBlock == BLOCK_AIR; }
+
+    // Returns the number of bits used to store each palette index (0 when uniform).
+    int getBitsPerEntry() const { return bitsPerEntry; }
+
+    // Returns the number of entries in the palette (including unused ones).
+    std::size_t getPaletteSize() const { return bitsPerEntry == 0 ? 1 : palette.size(); }
+
+    // Returns the approximate number of heap bytes owned by this section.
+    std::size_t memoryUsage() const;
+
+    // Returns the position of the given local block in the entry array, following the compile-time BlockLayout.
+    static int index(int x, int y, int z)
+    {
+        return BlockLayout<SECTION_SIZE>::index(x, y, z);
+    }
+
+private:
+    // Block filling the section while it is uniform.
+    BlockID uniformBlock;
+
+    // Block IDs referenced by the packed entries, empty while uniform.
+    std::vector<BlockID> palette;
+
+    // Number of entries referencing each palette slot; slots at zero are reused.
+    std::vector<std::uint16_t> paletteCounts;
+
+    // Packed palette indices, 64 / bitsPerEntry entries per word, empty while uniform.
+    PoolBuffer<std::uint64_t> entries;
+
+    // Width of each packed palette index, 0 while uniform.
+    int bitsPerEntry = 0;
+
+    // Returns the palette index stored at the given entry.
+    std::uint32_t readEntry(int i) const
+    {
+        const int perWordShift = 6 - log2Bits();
+        const std::uint64_t word = entries[i >> perWordShift];
+        const int shift = (i & ((1 << perWordShift) - 1)) * bitsPerEntry;
+        return (std::uint32_t)((word >> shift) & entryMask());
+    }
+
+    // Stores a palette index at the given entry.
+    void writeEntry(int i, std::uint32_t value);
+
+    // Returns the palette index of the block, adding it (and growing the entries) if missing.
+    std::uint32_t paletteIndexOf(BlockID block);
+
+    // Unpacks the SECTION_SIZE consecutive entries starting at entry i and maps them through the palette.
+    template <int Bits>
+    void decodeRow(int i, BlockID* out) const;
+
+    // Repacks the entries with the given number of bits per entry.
+    void resize(int newBitsPerEntry);
+
+    // Returns a zeroed entry array from the pool for the given width.
+    static PoolBuffer<std::uint64_t> allocateEntries(int bitsPerEntry);
+
+    // Converts a uniform section into a 1-bit paletted one holding the same block.
+    void expand();
+
+    // Makes the section uniform if a single palette slot is referenced by every entry.
+    void collapseIfUniform();
+
+    // Returns true if the box covers the whole section.
+    static bool coversSection(glm::ivec3 min, glm::ivec3 max)
+    {
+        return glm::all(glm::lessThanEqual(min, glm::ivec3(0))) && glm::all(glm::greaterThanEqual(max, glm::ivec3(SECTION_SIZE)));
+    }
+
+    int log2Bits() const
+    {
+        return bitsPerEntry == 1 ? 0 : bitsPerEntry == 2 ? 1 : bitsPerEntry == 4 ? 2 : bitsPerEntry == 8 ? 3 : 4;
+    }
+
+    std::uint64_t entryMask() const
+    {
+        return (std::uint64_t(1) << bitsPerEntry) - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ChunkStreamer.h"
+
+ChunkStreamer::ChunkStreamer(
+    World& world,
+    const TerrainGenerator& generator,
+    int horizontalRadius,
+    int verticalRadius,
+    int loadsPerUpdate
+)
+    : world(world), generator(generator), horizontalRadius(horizontalRadius),
+      verticalRadius(verticalRadius), loadsPerUpdate(loadsPerUpdate), center{ 0, 0, 0 }
+{
+}
+
+void ChunkStreamer::update(glm::vec3 cameraPos)
+{
+    const glm::ivec3 block(glm::floor(cameraPos));
+    const ChunkCoord cameraChunk = World::toChunkCoord(block.x, block.y, block.z);
+    if (!hasCenter || cameraChunk != center)
+    {
+        center = cameraChunk;
+        hasCenter = true;
+        unloadFar();
+        rebuildQueue();
+    }
+
+    for (int i = 0; i < loadsPerUpdate && !pending.empty(); i++)
+    {
+        const ChunkCoord coord = pending.back();
+        pending.pop_back();
+        generator.generate(world, coord);
+        loaded[coord] = 1;
+    }
+}
+
+std::int64_t ChunkStreamer::distance(ChunkCoord coord) const
+{
+    const std::int64_t dx = coord.x - center.x;
+    const std::int64_t dy = coord.y - center.y;
+    const std::int64_t dz = coord.z - center.z;
+    const std::int64_t h = horizontalRadius;
+    const std::int64_t v = verticalRadius;
+    return (dx * dx + dz * dz) * v * v + dy * dy * h * h;
+}
+
+bool ChunkStreamer::inRange(ChunkCoord coord, int margin) const
+{
+    const std::int64_t dx = coord.x - center.x;
+    const std::int64_t dy = coord.y - center.y;
+    const std::int64_t dz = coord.z - center.z;
+    const std::int64_t h = horizontalRadius + margin;
+    const std::int64_t v = verticalRadius + margin;
+    return (dx * dx + dz * dz) * v * v + dy * dy * h * h <= h * h * v * v;
+}
+
+void ChunkStreamer::rebuildQueue()
+{
+    pending.clear();
+    for (int dz = -horizontalRadius; dz <= horizontalRadius; dz++)
+        for (int dy = -verticalRadius; dy <= verticalRadius; dy++)
+            for (int dx = -horizontalRadius; dx <= horizontalRadius; dx++)
+            {
+                const ChunkCoord coord{ center.x + dx, center.y + dy, center.z + dz };
+                if (inRange(coord, 0) && !isLoaded(coord))
+                    pending.push_back(coord);
+            }
+
+    std::sort(pending.begin(), pending.end(), [&](const ChunkCoord& a, const ChunkCoord& b) {
+        return distance(a) > distance(b);
+    });
+}
+
+void ChunkStreamer::unloadFar()
+{
+    std::vector<ChunkCoord> far;
+    loaded.forEach([&](ChunkCoord coord, std::uint8_t) {
+        if (!inRange(coord, 1))
+            far.push_back(coord);
+    });
+
+    for (const ChunkCoord& coord : far)
+    {
+        loaded.erase(coord);
+        world.removeChunk(coord);
+    }
+
+    // Edits can create chunks the streamer never generated, which would otherwise stay loaded forever.
+    far.clear();
+    world.forEachChunk([&](ChunkCoord coord) {
+        if (!inRange(coord, 1))
+            far.push_back(coord);
+    });
+    for (const ChunkCoord& coord : far)
+        world.removeChunk(coord);
+}
@@ -0,0 +1,115 @@
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <../include/glm/glm.hpp>
+
+#include "../Chunk/Chunk.h"
+#include "../ChunkMap/ChunkMap.h"
+#include "../TerrainGenerator/TerrainGenerator.h"
+#include "../World/World.h"
+
+// Default number of chunks loaded in each horizontal direction from the camera's chunk.
+constexpr int STREAM_DEFAULT_HORIZONTAL_RADIUS = 8;
+
+// Default number of chunks loaded above and below the camera's chunk.
+constexpr int STREAM_DEFAULT_VERTICAL_RADIUS = 4;
+
+// Default number of chunks generated per call to ChunkStreamer::update.
+constexpr int STREAM_DEFAULT_LOADS_PER_UPDATE = 8;
+
+/*
+ * Loads and unloads cubic chunks around the camera on all three axes. The
+ * loaded volume is an ellipsoid with its own vertical radius, so a tall world
+ * only keeps the few chunks above and below the camera in memory instead of
+ * whole columns. Missing chunks are generated nearest first, with distance
+ * measured in units of each axis' radius, a few per update to bound frame time.
+ * Chunks that edits created out of range are unloaded along with generated ones.
+ */
+class ChunkStreamer
+{
+public:
+    /**
+     * Constructor creates a streamer with nothing loaded.
+     *
+     * @param world The world to load chunks into.
+     * @param generator The generator producing new chunks.
+     * @param horizontalRadius Number of chunks loaded in each horizontal direction.
+     * @param verticalRadius Number of chunks loaded above and below the camera.
+     * @param loadsPerUpdate Maximum number of chunks generated per update.
+     */
+    ChunkStreamer(
+        World& world,
+        const TerrainGenerator& generator,
+        int horizontalRadius = STREAM_DEFAULT_HORIZONTAL_RADIUS,
+        int verticalRadius = STREAM_DEFAULT_VERTICAL_RADIUS,
+        int loadsPerUpdate = STREAM_DEFAULT_LOADS_PER_UPDATE
+    );
+
+    /**
+     * Unloads chunks that fell out of range and generates the nearest missing ones.
+     * The load queue is only rebuilt when the camera enters a different chunk.
+     *
+     * @param cameraPos The camera position in world space.
+     */
+    void update(glm::vec3 cameraPos);
+
+    /**
+     * Returns true if the chunk has been generated, even if it turned out to be all air.
+     *
+     * @param coord The chunk coordinate.
+     */
+    bool isLoaded(ChunkCoord coord) const { return loaded.find(coord) != nullptr; }
+
+    // Returns the number of chunks generated and still in range.
+    std::size_t getLoadedCount() const { return loaded.size(); }
+
+    // Returns the number of chunks in range still waiting to be generated.
+    std::size_t getPendingCount() const { return pending.size(); }
+
+private:
+    World& world;
+    const TerrainGenerator& generator;
+    int horizontalRadius;
+    int verticalRadius;
+    int loadsPerUpdate;
+
+    // Chunks that have been generated; the value is unused. All-air chunks are tracked
+    // here without being created in the world.
+    ChunkMap<std::uint8_t> loaded;
+
+    // Chunks in range that are not loaded yet, farthest first so the nearest is popped from the back.
+    std::vector<ChunkCoord> pending;
+
+    // Chunk containing the camera when the queue was last rebuilt.
+    ChunkCoord center;
+    bool hasCenter = false;
+
+    /**
+     * Returns the distance of a chunk from the center scaled so the edge of the loaded
+     * ellipsoid is at horizontalRadius^2 * verticalRadius^2.
+     *
+     * @param coord The chunk coordinate.
+     * @return The scaled squared distance.
+     */
+    std::int64_t distance(ChunkCoord coord) const;
+
+    /**
+     * Returns true if the chunk lies within the loaded ellipsoid grown by margin chunks on every axis.
+     *
+     * @param coord The chunk coordinate.
+     * @param margin Extra chunks of tolerance, used to keep chunks loaded a little past the load radius.
+     */
+    bool inRange(ChunkCoord coord, int margin) const;
+
+    // Queues every chunk in range that is not loaded yet, sorted by distance.
+    void rebuildQueue();
+
+    // Unloads every chunk that is out of range by more than one chunk, including chunks created by edits.
+    void unloadFar();
+};
+
+#endif
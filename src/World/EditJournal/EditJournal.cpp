@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cmath>
+
+#include "EditJournal.h"
+
+EditJournal::EditJournal(std::size_t memoryBudget)
+    : memoryBudget(memoryBudget)
+{
+}
+
+template <typename Fn>
+void EditJournal::record(World& world, glm::ivec3 min, glm::ivec3 max, Fn&& edit)
+{
+    if (glm::any(glm::greaterThanEqual(min, max)))
+        return;
+
+    // Snapshots hold a reference to every section, so the edit has to copy any section it writes to.
+    const ChunkCoord first = World::toChunkCoord(min.x, min.y, min.z);
+    const ChunkCoord last = World::toChunkCoord(max.x - 1, max.y - 1, max.z - 1);
+    std::vector<ChunkSnapshot> before;
+    for (int cz = first.z; cz <= last.z; cz++)
+        for (int cy = first.y; cy <= last.y; cy++)
+            for (int cx = first.x; cx <= last.x; cx++)
+            {
+                const ChunkCoord coord{ cx, cy, cz };
+                const Chunk* chunk = world.getChunk(coord);
+                before.push_back(chunk ? chunk->snapshot() : ChunkSnapshot());
+                before.back().coord = coord;
+            }
+
+    edit(world);
+
+    Edit entry;
+    entry.bytes = sizeof(Edit);
+    for (const ChunkSnapshot& snapshot : before)
+    {
+        const Chunk* chunk = world.getChunk(snapshot.coord);
+        if (!chunk)
+            continue;
+
+        for (int i = 0; i < SECTIONS_PER_CHUNK; i++)
+        {
+            // Unloaded snapshots and new chunks share the same empty section, so untouched sections compare equal.
+            if (&snapshot.getSection(i) == &chunk->getSection(i))
+                continue;
+
+            SectionDiff diff{ snapshot.coord, i, {} };
+            diffSection(snapshot.getSection(i), chunk->getSection(i), diff.runs);
+            if (diff.runs.empty())
+                continue;
+
+            diff.runs.shrink_to_fit();
+            entry.bytes += sizeof(SectionDiff) + diff.runs.size() * sizeof(Run);
+            entry.sections.push_back(std::move(diff));
+        }
+    }
+
+    if (entry.sections.empty())
+        return;
+
+    // An edit larger than the whole budget cannot be kept, and the history around it no longer lines up
+    // with the world, so all of it goes.
+    if (entry.bytes > memoryBudget)
+    {
+        clear();
+        return;
+    }
+
+    for (const Edit& undone : redoStack)
+        usedBytes -= undone.bytes;
+    redoStack.clear();
+
+    usedBytes += entry.bytes;
+    undoStack.push_back(std::move(entry));
+    trim();
+}
+
+void EditJournal::fillBox(World& world, glm::ivec3 min, glm::ivec3 max, BlockID block)
+{
+    record(world, min, max, [&](World& target) { target.fillBox(min, max, block); });
+}
+
+void EditJournal::replaceBox(World& world, glm::ivec3 min, glm::ivec3 max, BlockID from, BlockID to)
+{
+    record(world, min, max, [&](World& target) { target.replaceBox(min, max, from, to); });
+}
+
+void EditJournal::fillSphere(World& world, glm::vec3 center, float radius, BlockID block)
+{
+    const glm::ivec3 min(glm::floor(center - radius));
+    const glm::ivec3 max = glm::ivec3(glm::ceil(center + radius)) + 1;
+    record(world, min, max, [&](World& target) { target.fillSphere(center, radius, block); });
+}
+
+bool EditJournal::undo(World& world)
+{
+    if (undoStack.empty())
+        return false;
+
+    if (!isLoaded(world, undoStack.back()))
+    {
+        usedBytes -= undoStack.back().bytes;
+        undoStack.pop_back();
+        return false;
+    }
+
+    apply(world, undoStack.back(), true);
+    redoStack.push_back(std::move(undoStack.back()));
+    undoStack.pop_back();
+    return true;
+}
+
+bool EditJournal::redo(World& world)
+{
+    if (redoStack.empty())
+        return false;
+
+    if (!isLoaded(world, redoStack.back()))
+    {
+        usedBytes -= redoStack.back().bytes;
+        redoStack.pop_back();
+        return false;
+    }
+
+    apply(world, redoStack.back(), false);
+    undoStack.push_back(std::move(redoStack.back()));
+    redoStack.pop_back();
+    return true;
+}
+
+void EditJournal::clear()
+{
+    undoStack.clear();
+    redoStack.clear();
+    usedBytes = 0;
+}
+
+bool EditJournal::isLoaded(const World& world, const Edit& edit)
+{
+    for (const SectionDiff& diff : edit.sections)
+    {
+        if (!world.getChunk(diff.chunk))
+            return false;
+    }
+    return true;
+}
+
+void EditJournal::apply(World& world, const Edit& edit, bool reverse)
+{
+    std::vector<BlockID> blocks(SECTION_VOLUME);
+    for (const SectionDiff& diff : edit.sections)
+    {
+        world.editSection(diff.chunk, diff.section, [&](ChunkSection& section) {
+            const Run& first = diff.runs.front();
+            if (first.length == SECTION_VOLUME)
+            {
+                section.fill(reverse ? first.before : first.after);
+                return true;
+            }
+
+            // Patch a decoded copy and re-encode it once, instead of updating packed entries run by run.
+            section.copyTo(blocks.data());
+            for (const Run& run : diff.runs)
+                std::fill_n(blocks.begin() + run.start, run.length, reverse ? run.before : run.after);
+            section.assign(blocks.data());
+            return true;
+        });
+    }
+}
+
+void EditJournal::diffSection(const ChunkSection& before, const ChunkSection& after, std::vector<Run>& runs)
+{
+    if (before.isUniform() && after.isUniform())
+    {
+        if (before.getUniformBlock() != after.getUniformBlock())
+            runs.push_back(Run{ 0, (std::uint16_t)SECTION_VOLUME, before.getUniformBlock(), after.getUniformBlock() });
+        return;
+    }
+
+    BlockID beforeRow[SECTION_SIZE];
+    BlockID afterRow[SECTION_SIZE];
+    for (int z = 0; z < SECTION_SIZE; z++)
+        for (int y = 0; y < SECTION_SIZE; y++)
+        {
+            before.copyRow(y, z, beforeRow);
+            after.copyRow(y, z, afterRow);
+            const int rowStart = SECTION_SIZE * (y + SECTION_SIZE * z);
+            for (int x = 0; x < SECTION_SIZE; x++)
+            {
+                if (beforeRow[x] == afterRow[x])
+                    continue;
+
+                const int n = rowStart + x;
+                if (!runs.empty())
+                {
+                    Run& previous = runs.back();
+                    if (previous.start + previous.length == n && previous.before == beforeRow[x] && previous.after == afterRow[x])
+                    {
+                        previous.length++;
+                        continue;
+                    }
+                }
+                runs.push_back(Run{ (std::uint16_t)n, 1, beforeRow[x], afterRow[x] });
+            }
+        }
+}
+
+void EditJournal::trim()
+{
+    while (usedBytes > memoryBudget && !undoStack.empty())
+    {
+        usedBytes -= undoStack.front().bytes;
+        undoStack.pop_front();
+    }
+}
@@ -0,0 +1,166 @@
+#ifndef EDIT_JOURNAL_H
+#define EDIT_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <../include/glm/glm.hpp>
+
+#include "../Block/Block.h"
+#include "../Chunk/Chunk.h"
+#include "../World/World.h"
+
+// Default number of bytes the journal may use before dropping its oldest edits.
+constexpr std::size_t EDIT_JOURNAL_DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+/*
+ * Undo/redo history for region edits. Each edit is stored as a diff of the
+ * sections it changed, run-length encoded in row order, so refilling a whole
+ * section costs a single run. Sections are found by snapshotting the chunks in
+ * the edit's bounds first: copy-on-write means exactly the sections the edit
+ * touched end up with a new pointer. Undo and redo write the runs back through
+ * World::editSection, decoding each section once, patching the runs in and
+ * re-encoding it, so undoing millions of blocks costs a few passes over memory.
+ *
+ * An edit whose diff alone exceeds the memory budget is applied but not
+ * journaled, and clears the history, whose diffs would no longer line up with
+ * the world. Undo and redo never
+ * bring back chunks that were unloaded since the edit: an edit touching one is
+ * dropped from the history instead of applied.
+ */
+class EditJournal
+{
+public:
+    /**
+     * Constructor creates an empty journal.
+     *
+     * @param memoryBudget Maximum number of bytes of history to keep; the oldest edits are dropped first,
+     *                     and a single edit larger than this clears the history instead.
+     */
+    explicit EditJournal(std::size_t memoryBudget = EDIT_JOURNAL_DEFAULT_BUDGET);
+
+    /**
+     * Sets every block in a box and records the edit.
+     *
+     * @param world The world to edit.
+     * @param min Minimum world corner of the box (inclusive).
+     * @param max Maximum world corner of the box (exclusive).
+     * @param block The ID of the new block.
+     */
+    void fillBox(World& world, glm::ivec3 min, glm::ivec3 max, BlockID block);
+
+    /**
+     * Replaces one block type with another inside a box and records the edit.
+     *
+     * @param world The world to edit.
+     * @param min Minimum world corner of the box (inclusive).
+     * @param max Maximum world corner of the box (exclusive).
+     * @param from The block to replace.
+     * @param to The block to replace it with.
+     */
+    void replaceBox(World& world, glm::ivec3 min, glm::ivec3 max, BlockID from, BlockID to);
+
+    /**
+     * Sets every block whose center lies within a sphere and records the edit.
+     *
+     * @param world The world to edit.
+     * @param center Center of the sphere in world space.
+     * @param radius Radius of the sphere in blocks.
+     * @param block The ID of the new block.
+     */
+    void fillSphere(World& world, glm::vec3 center, float radius, BlockID block);
+
+    /**
+     * Reverts the most recent edit.
+     *
+     * @param world The world the edit was made in.
+     * @return False if there was nothing to undo, or if the edit touched a chunk that has been
+     *         unloaded since, in which case it is dropped.
+     */
+    bool undo(World& world);
+
+    /**
+     * Reapplies the most recently undone edit.
+     *
+     * @param world The world the edit was made in.
+     * @return False if there was nothing to redo, or if the edit touched a chunk that has been
+     *         unloaded since, in which case it is dropped.
+     */
+    bool redo(World& world);
+
+    // Returns true if there is an edit to undo.
+    bool canUndo() const { return !undoStack.empty(); }
+
+    // Returns true if there is an edit to redo.
+    bool canRedo() const { return !redoStack.empty(); }
+
+    // Discards all history.
+    void clear();
+
+    // Returns the number of bytes used by the recorded history.
+    std::size_t memoryUsage() const { return usedBytes; }
+
+private:
+    // Consecutive changed blocks sharing the same old and new block, in section row order.
+    struct Run
+    {
+        std::uint16_t start;
+        std::uint16_t length;
+        BlockID before;
+        BlockID after;
+    };
+
+    // The changes one edit made to one section.
+    struct SectionDiff
+    {
+        ChunkCoord chunk;
+        int section;
+        std::vector<Run> runs;
+    };
+
+    struct Edit
+    {
+        std::vector<SectionDiff> sections;
+        std::size_t bytes = 0;
+    };
+
+    std::size_t memoryBudget;
+    std::size_t usedBytes = 0;
+
+    // Oldest edits at the front, so they can be dropped when over budget.
+    std::deque<Edit> undoStack;
+    std::vector<Edit> redoStack;
+
+    /**
+     * Runs an edit on the world and records the sections it changed.
+     *
+     * @param world The world to edit.
+     * @param min Minimum world corner of every block the edit may change (inclusive).
+     * @param max Maximum world corner of every block the edit may change (exclusive).
+     * @param edit Called with the world to perform the edit.
+     */
+    template <typename Fn>
+    void record(World& world, glm::ivec3 min, glm::ivec3 max, Fn&& edit);
+
+    // Returns true if every chunk an edit changed is still loaded.
+    static bool isLoaded(const World& world, const Edit& edit);
+
+    /**
+     * Writes an edit's old or new blocks back into the world.
+     *
+     * @param world The world to write to.
+     * @param edit The edit to apply; every chunk it changed must be loaded.
+     * @param reverse Whether to restore the blocks from before the edit.
+     */
+    static void apply(World& world, const Edit& edit, bool reverse);
+
+    // Appends the runs of blocks that differ between two versions of a section.
+    static void diffSection(const ChunkSection& before, const ChunkSection& after, std::vector<Run>& runs);
+
+    // Drops the oldest edits until the history fits the memory budget.
+    void trim();
+};
+
+#endif
@@ -0,0 +1,284 @@
+#include <cstring>
+#include <random>
+
+#include "FaceClassifier.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FACE_CLASSIFIER_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC compiles AVX2 intrinsics without /arch:AVX2, so only the runtime check guards them.
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FACE_CLASSIFIER_NEON
+#include <arm_neon.h>
+#endif
+
+// Offset of the neighbor across each face in the padded array, indexed by BlockFace.
+static const int NEIGHBOR_OFFSETS[FACE_COUNT] = { 1, -1, PADDED_SIZE, -PADDED_SIZE, PADDED_AREA, -PADDED_AREA };
+
+/**
+ * Returns the face mask of one block. This is the reference every path must match.
+ *
+ * @param block The block in the padded array.
+ * @param opacity Opacity of every block ID, 0 or -1.
+ * @return Bit f set when face f is visible.
+ */
+static std::uint8_t classifyBlock(const BlockID* block, const std::int32_t* opacity)
+{
+    if (*block == BLOCK_AIR)
+        return 0;
+
+    std::uint8_t mask = 0;
+    for (int face = 0; face < FACE_COUNT; face++)
+    {
+        const BlockID neighbor = block[NEIGHBOR_OFFSETS[face]];
+        if (opacity[neighbor] == 0 && neighbor != *block)
+            mask |= (std::uint8_t)(1 << face);
+    }
+    return mask;
+}
+
+// Returns this thread's buffer for the opacity of every block of a padded chunk, as 0 or 0xFFFF.
+static std::uint16_t* opacityScratch()
+{
+    thread_local std::vector<std::uint16_t> scratch(PADDED_VOLUME);
+    return scratch.data();
+}
+
+#ifdef FACE_CLASSIFIER_AVX2
+// Returns true if the CPU and the operating system support AVX2.
+static bool cpuHasAVX2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // AVX needs the OS to save the ymm registers, which OSXSAVE and XCR0 report.
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+FaceClassifier::FaceClassifier(const std::uint8_t* opaque, std::size_t count)
+    : path(detectPath()), opacity(count)
+{
+    for (std::size_t block = 0; block < count; block++)
+        opacity[block] = opaque[block] ? -1 : 0;
+}
+
+void FaceClassifier::classify(const BlockID* blocks, std::uint8_t* faces, SimdPath simd) const
+{
+#ifdef FACE_CLASSIFIER_AVX2
+    if (simd == SimdPath::AVX2)
+        return classifyAVX2(blocks, faces);
+#endif
+#ifdef FACE_CLASSIFIER_NEON
+    if (simd == SimdPath::NEON)
+        return classifyNEON(blocks, faces);
+#endif
+    classifyScalar(blocks, faces);
+}
+
+bool FaceClassifier::matchesScalar(int chunks, std::uint32_t seed) const
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> anyBlock(0, (int)opacity.size() - 1);
+    std::uniform_int_distribution<int> run(1, 4);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    static const double AIR_SHARES[4] = { 0.0, 0.25, 0.5, 0.9 };
+
+    std::vector<BlockID> blocks(PADDED_VOLUME);
+    std::vector<std::uint8_t> expected(CHUNK_VOLUME);
+    std::vector<std::uint8_t> faces(CHUNK_VOLUME);
+    for (int chunk = 0; chunk < chunks; chunk++)
+    {
+        // Every other chunk draws from three blocks only, so equal transparent neighbors meet along every axis.
+        const BlockID palette[3] = { (BlockID)anyBlock(rng), (BlockID)anyBlock(rng), (BlockID)anyBlock(rng) };
+        const bool usePalette = chunk % 2 == 1;
+        const double air = AIR_SHARES[chunk / 2 % 4];
+        for (int i = 0; i < PADDED_VOLUME;)
+        {
+            BlockID id = usePalette ? palette[rng() % 3] : (BlockID)anyBlock(rng);
+            if (chance(rng) < air)
+                id = BLOCK_AIR;
+            for (int n = run(rng); n > 0 && i < PADDED_VOLUME; n--)
+                blocks[i++] = id;
+        }
+
+        classifyScalar(blocks.data(), expected.data());
+        for (SimdPath simd : { SimdPath::AVX2, SimdPath::NEON })
+        {
+            if (!isSupported(simd))
+                continue;
+
+            classify(blocks.data(), faces.data(), simd);
+            if (std::memcmp(faces.data(), expected.data(), CHUNK_VOLUME) != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool FaceClassifier::isSupported(SimdPath simd)
+{
+    switch (simd)
+    {
+    case SimdPath::Scalar:
+        return true;
+    case SimdPath::AVX2:
+#ifdef FACE_CLASSIFIER_AVX2
+    {
+        static const bool supported = cpuHasAVX2();
+        return supported;
+    }
+#else
+        return false;
+#endif
+    case SimdPath::NEON:
+#ifdef FACE_CLASSIFIER_NEON
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+SimdPath FaceClassifier::detectPath()
+{
+    if (isSupported(SimdPath::AVX2))
+        return SimdPath::AVX2;
+    if (isSupported(SimdPath::NEON))
+        return SimdPath::NEON;
+    return SimdPath::Scalar;
+}
+
+const char* FaceClassifier::getPathName(SimdPath simd)
+{
+    switch (simd)
+    {
+    case SimdPath::AVX2:
+        return "AVX2";
+    case SimdPath::NEON:
+        return "NEON";
+    default:
+        return "scalar";
+    }
+}
+
+void FaceClassifier::classifyScalar(const BlockID* blocks, std::uint8_t* faces) const
+{
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const BlockID* row = blocks + PaddedChunk::index(0, y, z);
+            for (int x = 0; x < CHUNK_SIZE; x++)
+                *faces++ = classifyBlock(row + x, opacity.data());
+        }
+}
+
+#ifdef FACE_CLASSIFIER_AVX2
+TARGET_AVX2 void FaceClassifier::classifyAVX2(const BlockID* blocks, std::uint8_t* faces) const
+{
+    // Look up the opacity of every padded block, gathering 8 at a time from the 32-bit table.
+    std::uint16_t* opaque = opacityScratch();
+    const int* table = opacity.data();
+    int i = 0;
+    for (; i + 16 <= PADDED_VOLUME; i += 16)
+    {
+        const __m256i ids = _mm256_loadu_si256((const __m256i*)(blocks + i));
+        const __m256i low = _mm256_i32gather_epi32(table, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(ids)), 4);
+        const __m256i high = _mm256_i32gather_epi32(table, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(ids, 1)), 4);
+
+        // The pack works within 128-bit lanes; the permute puts the quadwords back in block order.
+        _mm256_storeu_si256((__m256i*)(opaque + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8));
+    }
+    for (; i < PADDED_VOLUME; i++)
+        opaque[i] = (std::uint16_t)table[blocks[i]];
+
+    const __m256i zero = _mm256_setzero_si256();
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const int row = PaddedChunk::index(0, y, z);
+            std::uint8_t* out = faces + (y + z * CHUNK_SIZE) * CHUNK_SIZE;
+            int x = 0;
+            for (; x + 16 <= CHUNK_SIZE; x += 16)
+            {
+                const int center = row + x;
+                const __m256i block = _mm256_loadu_si256((const __m256i*)(blocks + center));
+                __m256i mask = zero;
+                for (int face = 0; face < FACE_COUNT; face++)
+                {
+                    const int neighbor = center + NEIGHBOR_OFFSETS[face];
+                    const __m256i same = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(blocks + neighbor)), block);
+                    const __m256i hidden = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(opaque + neighbor)), same);
+                    mask = _mm256_or_si256(mask, _mm256_andnot_si256(hidden, _mm256_set1_epi16((short)(1 << face))));
+                }
+                mask = _mm256_andnot_si256(_mm256_cmpeq_epi16(block, zero), mask);
+
+                // Narrow to bytes; quadwords 0 and 2 of the pack hold blocks 0-7 and 8-15.
+                const __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(mask, mask), 0x08);
+                _mm_storeu_si128((__m128i*)(out + x), _mm256_castsi256_si128(bytes));
+            }
+            for (; x < CHUNK_SIZE; x++)
+                out[x] = classifyBlock(blocks + row + x, table);
+        }
+}
+#endif
+
+#ifdef FACE_CLASSIFIER_NEON
+void FaceClassifier::classifyNEON(const BlockID* blocks, std::uint8_t* faces) const
+{
+    // NEON has no gather, so the opacity lookups are scalar; the comparisons below are not.
+    std::uint16_t* opaque = opacityScratch();
+    const int* table = opacity.data();
+    for (int i = 0; i < PADDED_VOLUME; i++)
+        opaque[i] = (std::uint16_t)table[blocks[i]];
+
+    const uint16x8_t zero = vdupq_n_u16(0);
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+        {
+            const int row = PaddedChunk::index(0, y, z);
+            std::uint8_t* out = faces + (y + z * CHUNK_SIZE) * CHUNK_SIZE;
+            int x = 0;
+            for (; x + 16 <= CHUNK_SIZE; x += 16)
+            {
+                uint8x8_t halves[2];
+                for (int half = 0; half < 2; half++)
+                {
+                    const int center = row + x + half * 8;
+                    const uint16x8_t block = vld1q_u16(blocks + center);
+                    uint16x8_t mask = zero;
+                    for (int face = 0; face < FACE_COUNT; face++)
+                    {
+                        const int neighbor = center + NEIGHBOR_OFFSETS[face];
+                        const uint16x8_t hidden = vorrq_u16(vld1q_u16(opaque + neighbor), vceqq_u16(vld1q_u16(blocks + neighbor), block));
+                        mask = vorrq_u16(mask, vbicq_u16(vdupq_n_u16((std::uint16_t)(1 << face)), hidden));
+                    }
+                    halves[half] = vmovn_u16(vbicq_u16(mask, vceqq_u16(block, zero)));
+                }
+                vst1q_u8(out + x, vcombine_u8(halves[0], halves[1]));
+            }
+            for (; x < CHUNK_SIZE; x++)
+                out[x] = classifyBlock(blocks + row + x, table);
+        }
+}
+#endif
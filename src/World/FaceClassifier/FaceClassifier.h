@@ -0,0 +1,93 @@
+#ifndef FACE_CLASSIFIER_H
+#define FACE_CLASSIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../Block/Block.h"
+#include "../BlockRegistry/BlockRegistry.h"
+#include "../PaddedChunk/PaddedChunk.h"
+
+// Instruction sets the face classifier can run on.
+enum class SimdPath
+{
+    Scalar,
+    AVX2,
+    NEON
+};
+
+/*
+ * Finds the visible faces of every block of a padded chunk. A face is visible
+ * when the block is not air and its neighbor across the face is neither opaque
+ * nor the same block. The result is one byte per block of the chunk, in
+ * x-fastest order, with bit f set when face f (a BlockFace) is visible.
+ *
+ * The SIMD paths work 16 blocks at a time in two passes over the padded array:
+ * the opacity of every block is looked up first (with gathers on AVX2), then
+ * each block is compared against its six neighbors. The fastest path the CPU
+ * supports is picked at runtime; the scalar path is the reference the others
+ * must match bit for bit.
+ */
+class FaceClassifier
+{
+public:
+    /**
+     * Constructor copies the opacity table and picks the instruction set.
+     *
+     * @param opaque Opacity of every block ID, nonzero for opaque blocks.
+     * @param count Number of block IDs in the table; blocks passed to classify() must be below it.
+     */
+    FaceClassifier(const std::uint8_t* opaque, std::size_t count);
+
+    /**
+     * Classifies the faces of a chunk with the fastest supported path.
+     *
+     * @param blocks The padded block array of the chunk.
+     * @param faces Receives CHUNK_VOLUME face masks.
+     */
+    void classify(const BlockID* blocks, std::uint8_t* faces) const { classify(blocks, faces, path); }
+
+    /**
+     * Classifies the faces of a chunk with the given path, which must be supported.
+     *
+     * @param blocks The padded block array of the chunk.
+     * @param faces Receives CHUNK_VOLUME face masks.
+     * @param simd The instruction set to use.
+     */
+    void classify(const BlockID* blocks, std::uint8_t* faces, SimdPath simd) const;
+
+    /**
+     * Classifies random chunks drawn from every block ID of the table, air and transparent blocks
+     * included, with every supported path and compares each against the scalar path bit for bit.
+     *
+     * @param chunks Number of random chunks to classify.
+     * @param seed Seed of the random blocks.
+     * @return True if every supported path matched the scalar path on every chunk.
+     */
+    bool matchesScalar(int chunks, std::uint32_t seed) const;
+
+    // Returns the path classify() uses by default.
+    SimdPath getPath() const { return path; }
+
+    // Returns true if the CPU and the build support the path.
+    static bool isSupported(SimdPath simd);
+
+    // Returns the fastest supported path.
+    static SimdPath detectPath();
+
+    // Returns the name of a path, for logging.
+    static const char* getPathName(SimdPath simd);
+
+private:
+    SimdPath path;
+
+    // Opacity of every block ID as 0 or -1, 32 bits wide so AVX2 can gather it.
+    std::vector<std::int32_t> opacity;
+
+    void classifyScalar(const BlockID* blocks, std::uint8_t* faces) const;
+    void classifyAVX2(const BlockID* blocks, std::uint8_t* faces) const;
+    void classifyNEON(const BlockID* blocks, std::uint8_t* faces) const;
+};
+
+#endif
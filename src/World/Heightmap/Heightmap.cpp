@@ -0,0 +1,19 @@
+#include "Heightmap.h"
+
+Heightmap::Heightmap()
+{
+    heights.fill(HEIGHT_NONE);
+}
+
+void Heightmap::addChunk(int chunkY)
+{
+    if (chunkCount == 0 || chunkY < lowestChunk)
+        lowestChunk = chunkY;
+    chunkCount++;
+}
+
+bool Heightmap::removeChunk()
+{
+    chunkCount--;
+    return chunkCount == 0;
+}
@@ -0,0 +1,68 @@
+#ifndef HEIGHTMAP_H
+#define HEIGHTMAP_H
+
+#include <array>
+#include <limits>
+
+#include "../Chunk/Chunk.h"
+
+// Height of a column that has no non-air block in any loaded chunk.
+constexpr int HEIGHT_NONE = std::numeric_limits<int>::min();
+
+/*
+ * World y-position of the highest non-air block in every column of one chunk
+ * column (all loaded chunks sharing the same chunk x and z). Kept up to date by
+ * World as blocks change, so sky light, surface passes and the like can read the
+ * surface directly instead of scanning down each column.
+ */
+class Heightmap
+{
+public:
+    // Constructor creates a heightmap of empty columns.
+    Heightmap();
+
+    /**
+     * Returns the height of a column.
+     *
+     * @param x Local x-position, in [0, CHUNK_SIZE).
+     * @param z Local z-position, in [0, CHUNK_SIZE).
+     * @return The world y-position of the highest non-air block, or HEIGHT_NONE.
+     */
+    int get(int x, int z) const { return heights[x + z * CHUNK_SIZE]; }
+
+    /**
+     * Sets the height of a column.
+     *
+     * @param x Local x-position, in [0, CHUNK_SIZE).
+     * @param z Local z-position, in [0, CHUNK_SIZE).
+     * @param y The world y-position of the highest non-air block, or HEIGHT_NONE.
+     */
+    void set(int x, int z, int y) { heights[x + z * CHUNK_SIZE] = y; }
+
+    // Returns the heights of all CHUNK_AREA columns, indexed by x + z * CHUNK_SIZE.
+    const int* data() const { return heights.data(); }
+
+    // Records that a chunk at the given chunk y-position was loaded into this column.
+    void addChunk(int chunkY);
+
+    /**
+     * Records that one of the column's chunks was unloaded.
+     *
+     * @return True if the column has no loaded chunks left.
+     */
+    bool removeChunk();
+
+    // Returns the lowest chunk y-position loaded into this column, where downward scans can stop.
+    int getLowestChunk() const { return lowestChunk; }
+
+private:
+    std::array<int, CHUNK_AREA> heights;
+
+    // Number of loaded chunks in the column.
+    int chunkCount = 0;
+
+    // Lowest loaded chunk; only lowered while chunks stay loaded, so scans may visit unloaded gaps.
+    int lowestChunk = 0;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <utility>
+
+#include "MeshWorkers.h"
+#include "../PaddedChunk/PaddedChunk.h"
+
+MeshWorkers::MeshWorkers(const ChunkMesher& mesher, const SurfaceNetsMesher& surfaceMesher, ChunkMeshFormat format,
+                         unsigned threadCount)
+    : mesher(mesher), surfaceMesher(surfaceMesher), format(format)
+{
+    threadCount = std::max(threadCount, 1u);
+    for (unsigned i = 0; i < threadCount; i++)
+        threads.emplace_back(&MeshWorkers::run, this);
+}
+
+MeshWorkers::~MeshWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void MeshWorkers::submit(MeshJob job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+void MeshWorkers::collect(std::vector<MeshResult>& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (MeshResult& result : results)
+        out.push_back(std::move(result));
+    results.clear();
+}
+
+std::size_t MeshWorkers::getQueuedCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+unsigned MeshWorkers::defaultThreadCount()
+{
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+void MeshWorkers::run()
+{
+    // Each thread keeps its own scratch buffers for its whole lifetime.
+    PaddedChunk blocks;
+    std::vector<ChunkVertex> vertices;
+    std::vector<std::uint32_t> faces;
+    std::vector<SurfaceVertex> surfaceVertices;
+    std::vector<std::uint32_t> surfaceIndices;
+
+    while (true)
+    {
+        MeshJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if (stopping)
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        vertices.clear();
+        faces.clear();
+        surfaceVertices.clear();
+        surfaceIndices.clear();
+        if (format == ChunkMeshFormat::SurfaceNets)
+        {
+            // An empty chunk can still own the surface along its border with a solid neighbor.
+            blocks.fill(job.neighborhood);
+            surfaceMesher.mesh(blocks, surfaceVertices, surfaceIndices);
+        }
+        else if (!job.neighborhood.center().isEmpty())
+        {
+            blocks.fill(job.neighborhood);
+            if (format == ChunkMeshFormat::Faces)
+                mesher.meshFaces(blocks, faces);
+            else
+                mesher.mesh(blocks, vertices);
+        }
+
+        // Copy out so the scratch vectors keep their capacity for the next job.
+        MeshResult result{ job.coord, job.version, std::vector<ChunkVertex>(vertices.begin(), vertices.end()),
+                           std::vector<std::uint32_t>(faces.begin(), faces.end()),
+                           std::vector<SurfaceVertex>(surfaceVertices.begin(), surfaceVertices.end()),
+                           std::vector<std::uint32_t>(surfaceIndices.begin(), surfaceIndices.end()) };
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(std::move(result));
+        }
+    }
+}
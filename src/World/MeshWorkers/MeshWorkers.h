@@ -0,0 +1,106 @@
+#ifndef MESH_WORKERS_H
+#define MESH_WORKERS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Chunk/Chunk.h"
+#include "../ChunkMesher/ChunkMesher.h"
+#include "../ChunkNeighborhood/ChunkNeighborhood.h"
+#include "../SurfaceNetsMesher/SurfaceNetsMesher.h"
+
+// A chunk to mesh, with snapshots of everything the mesher reads.
+struct MeshJob
+{
+    ChunkCoord coord;
+
+    // Lets the submitter recognise results of jobs that were superseded while running.
+    std::uint32_t version;
+
+    ChunkNeighborhood neighborhood;
+};
+
+// The mesh built for a job.
+struct MeshResult
+{
+    ChunkCoord coord;
+    std::uint32_t version;
+
+    // Filled in the Vertices format.
+    std::vector<ChunkVertex> vertices;
+
+    // Filled in the Faces format.
+    std::vector<std::uint32_t> faces;
+
+    // Filled in the SurfaceNets format.
+    std::vector<SurfaceVertex> surfaceVertices;
+    std::vector<std::uint32_t> surfaceIndices;
+};
+
+/*
+ * Background threads that mesh chunks. Jobs carry copy-on-write snapshots, so
+ * the world can keep changing on the main thread while they run; results are
+ * handed back through collect() for the main thread to upload.
+ */
+class MeshWorkers
+{
+public:
+    /**
+     * Constructor starts the worker threads.
+     *
+     * @param mesher The mesher to run, shared by every thread.
+     * @param surfaceMesher The mesher to run in the SurfaceNets format, shared by every thread.
+     * @param format What the results hold.
+     * @param threadCount Number of threads to start, at least one.
+     */
+    MeshWorkers(const ChunkMesher& mesher, const SurfaceNetsMesher& surfaceMesher,
+                ChunkMeshFormat format = ChunkMeshFormat::Vertices, unsigned threadCount = defaultThreadCount());
+
+    // Destructor discards pending jobs and joins the threads.
+    ~MeshWorkers();
+
+    MeshWorkers(const MeshWorkers&) = delete;
+    MeshWorkers& operator=(const MeshWorkers&) = delete;
+
+    /**
+     * Queues a chunk for meshing. Jobs are started in submission order.
+     *
+     * @param job The job.
+     */
+    void submit(MeshJob job);
+
+    /**
+     * Moves every finished result into out without waiting for running jobs.
+     *
+     * @param out The list to append the results to.
+     */
+    void collect(std::vector<MeshResult>& out);
+
+    // Returns the number of jobs that have not been started yet.
+    std::size_t getQueuedCount();
+
+    // Returns one thread per hardware thread except the one running the main loop.
+    static unsigned defaultThreadCount();
+
+private:
+    const ChunkMesher& mesher;
+    const SurfaceNetsMesher& surfaceMesher;
+    ChunkMeshFormat format;
+    std::vector<std::thread> threads;
+
+    // Guards jobs, results and stopping.
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<MeshJob> jobs;
+    std::vector<MeshResult> results;
+    bool stopping = false;
+
+    // Worker thread loop.
+    void run();
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include <algorithm>
+
+#include "Octree.h"
+#include "../VoxelStorage/Raycast.h"
+
+
+Octree::Octree(int depth)
+    : nodes{ Node{ 0, BLOCK_AIR } }, depth(std::min(depth, OCTREE_MAX_DEPTH)), size(1 << this->depth),
+      origin(-size / 2)
+{
+}
+
+BlockID Octree::getBlock(int x, int y, int z) const
+{
+    if (!contains(x, y, z))
+        return BLOCK_AIR;
+
+    const int rx = x - origin, ry = y - origin, rz = z - origin;
+    std::uint32_t node = 0;
+    for (int half = size / 2; nodes[node].children != 0; half /= 2)
+        node = nodes[node].children + childIndex(rx, ry, rz, half);
+    return nodes[node].block;
+}
+
+void Octree::setBlock(int x, int y, int z, BlockID block)
+{
+    if (!contains(x, y, z))
+        return;
+
+    const int rx = x - origin, ry = y - origin, rz = z - origin;
+
+    // Descend to the unit leaf, splitting leaves that hold a different block.
+    std::array<std::uint32_t, OCTREE_MAX_DEPTH> path;
+    int pathLength = 0;
+    std::uint32_t node = 0;
+    for (int half = size / 2; half > 0; half /= 2)
+    {
+        if (nodes[node].children == 0)
+        {
+            if (nodes[node].block == block)
+                return;
+            const std::uint32_t children = allocateGroup(nodes[node].block);
+            nodes[node].children = children;
+        }
+        path[pathLength++] = node;
+        node = nodes[node].children + childIndex(rx, ry, rz, half);
+    }
+
+    if (nodes[node].block == block)
+        return;
+    nodes[node].block = block;
+
+    // Collapse parents whose children are now identical leaves.
+    while (pathLength > 0)
+    {
+        const std::uint32_t parent = path[--pathLength];
+        const std::uint32_t children = nodes[parent].children;
+        for (int i = 0; i < 8; i++)
+        {
+            if (nodes[children + i].children != 0 || nodes[children + i].block != block)
+                return;
+        }
+        nodes[parent] = Node{ 0, block };
+        freeGroups.push_back(children);
+    }
+}
+
+std::size_t Octree::memoryUsage() const
+{
+    return nodes.capacity() * sizeof(Node) + freeGroups.capacity() * sizeof(std::uint32_t);
+}
+
+bool Octree::raycast(glm::vec3 rayOrigin, glm::vec3 direction, float maxDistance, RaycastHit& hit) const
+{
+    return traverseLeaves(rayOrigin, direction, maxDistance, glm::ivec3(origin), size,
+        [this](glm::ivec3 cell, glm::ivec3& leafMin, int& leafSize) {
+            return findLeaf(cell.x, cell.y, cell.z, leafMin, leafSize);
+        },
+        hit);
+}
+
+BlockID Octree::findLeaf(int x, int y, int z, glm::ivec3& leafMin, int& leafSize) const
+{
+    const int rx = x - origin, ry = y - origin, rz = z - origin;
+    std::uint32_t node = 0;
+    leafSize = size;
+    while (nodes[node].children != 0)
+    {
+        leafSize /= 2;
+        node = nodes[node].children + childIndex(rx, ry, rz, leafSize);
+    }
+
+    leafMin = glm::ivec3(rx & ~(leafSize - 1), ry & ~(leafSize - 1), rz & ~(leafSize - 1)) + origin;
+    return nodes[node].block;
+}
+
+std::uint32_t Octree::allocateGroup(BlockID block)
+{
+    std::uint32_t first;
+    if (!freeGroups.empty())
+    {
+        first = freeGroups.back();
+        freeGroups.pop_back();
+    }
+    else
+    {
+        first = (std::uint32_t)nodes.size();
+        nodes.resize(nodes.size() + 8);
+    }
+
+    for (int i = 0; i < 8; i++)
+        nodes[first + i] = Node{ 0, block };
+    return first;
+}
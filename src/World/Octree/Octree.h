@@ -0,0 +1,145 @@
+#ifndef OCTREE_H
+#define OCTREE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <../include/glm/glm.hpp>
+
+#include "../Block/Block.h"
+#include "../VoxelStorage/VoxelStorage.h"
+
+// Default octree depth, covering 2^16 blocks along each axis.
+constexpr int OCTREE_DEFAULT_DEPTH = 16;
+
+// Deepest supported tree, whose 2^depth blocks per axis still fit in an int.
+constexpr int OCTREE_MAX_DEPTH = 30;
+
+/*
+ * Sparse voxel octree covering a cube of 2^depth blocks centered on the origin.
+ * Any node whose eight children would hold the same block is collapsed into a
+ * single leaf, so large empty or solid volumes cost one node each.
+ */
+class Octree final : public VoxelStorage
+{
+public:
+    /**
+     * Constructor creates an octree filled with air.
+     *
+     * @param depth Number of levels below the root, clamped to OCTREE_MAX_DEPTH; the tree spans
+     *              2^depth blocks per axis.
+     */
+    explicit Octree(int depth = OCTREE_DEFAULT_DEPTH);
+
+    BlockID getBlock(int x, int y, int z) const override;
+
+    // Sets a block, splitting leaves on the way down and collapsing uniform nodes on the way up. Ignored outside the tree.
+    void setBlock(int x, int y, int z, BlockID block) override;
+
+    std::size_t memoryUsage() const override;
+
+    /**
+     * Calls fn(glm::ivec3 min, glm::ivec3 max, BlockID) once per homogeneous box intersecting
+     * the region. Boxes are clipped to the region and max is exclusive.
+     *
+     * @param min Minimum corner of the region (inclusive).
+     * @param max Maximum corner of the region (exclusive).
+     * @param fn The function to call.
+     */
+    template <typename Fn>
+    void forEachInRegion(glm::ivec3 min, glm::ivec3 max, Fn&& fn) const
+    {
+        visitRegion(0, glm::ivec3(origin), size, glm::max(min, glm::ivec3(origin)), glm::min(max, glm::ivec3(origin + size)), fn);
+    }
+
+    /**
+     * Finds the first non-air block along a ray, skipping whole empty nodes at a time.
+     *
+     * @param rayOrigin Start of the ray in world space.
+     * @param direction Direction of the ray (does not need to be normalized).
+     * @param maxDistance Maximum distance along the ray, in units of the direction's length.
+     * @param hit Receives the hit information.
+     * @return True if a block was hit.
+     */
+    bool raycast(glm::vec3 rayOrigin, glm::vec3 direction, float maxDistance, RaycastHit& hit) const;
+
+    // Returns the number of allocated nodes (including free ones).
+    std::size_t getNodeCount() const { return nodes.size(); }
+
+    // Returns the minimum corner of the region covered by the tree.
+    int getOrigin() const { return origin; }
+
+    // Returns the number of blocks along each axis of the tree.
+    int getSize() const { return size; }
+
+private:
+    struct Node
+    {
+        // Index of the first of eight contiguous children, 0 for a leaf.
+        std::uint32_t children;
+
+        // Block filling the node when it is a leaf.
+        BlockID block;
+    };
+
+    // Nodes stored in groups of eight siblings, with the root at index 0.
+    std::vector<Node> nodes;
+
+    // Indices of sibling groups freed by collapsing, reused before growing the node array.
+    std::vector<std::uint32_t> freeGroups;
+
+    int depth;
+    int size;
+    int origin;
+
+    // Returns the octant of a position at the level where nodes span the given size.
+    static int childIndex(int x, int y, int z, int halfSize)
+    {
+        return ((x & halfSize) ? 1 : 0) | ((y & halfSize) ? 2 : 0) | ((z & halfSize) ? 4 : 0);
+    }
+
+    bool contains(int x, int y, int z) const
+    {
+        return x >= origin && y >= origin && z >= origin && x < origin + size && y < origin + size && z < origin + size;
+    }
+
+    /**
+     * Finds the leaf containing a position.
+     *
+     * @param x World x-position inside the tree.
+     * @param y World y-position inside the tree.
+     * @param z World z-position inside the tree.
+     * @param leafMin Receives the minimum corner of the leaf.
+     * @param leafSize Receives the size of the leaf.
+     * @return The block filling the leaf.
+     */
+    BlockID findLeaf(int x, int y, int z, glm::ivec3& leafMin, int& leafSize) const;
+
+    // Allocates eight leaf children filled with the given block and returns the first index.
+    std::uint32_t allocateGroup(BlockID block);
+
+    template <typename Fn>
+    void visitRegion(std::uint32_t node, glm::ivec3 nodeMin, int nodeSize, glm::ivec3 min, glm::ivec3 max, Fn& fn) const
+    {
+        const glm::ivec3 nodeMax = nodeMin + nodeSize;
+        if (glm::any(glm::greaterThanEqual(nodeMin, max)) || glm::any(glm::lessThanEqual(nodeMax, min)))
+            return;
+
+        if (nodes[node].children == 0)
+        {
+            fn(glm::max(nodeMin, min), glm::min(nodeMax, max), nodes[node].block);
+            return;
+        }
+
+        const int half = nodeSize / 2;
+        for (int i = 0; i < 8; i++)
+        {
+            const glm::ivec3 childMin = nodeMin + glm::ivec3((i & 1) ? half : 0, (i & 2) ? half : 0, (i & 4) ? half : 0);
+            visitRegion(nodes[node].children + i, childMin, half, min, max, fn);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include <algorithm>
+
+#include "PaddedChunk.h"
+#include "../ChunkPools/ChunkPools.h"
+
+
+static_assert(MESH_SCRATCH_BYTES >= PADDED_VOLUME * sizeof(BlockID), "mesh scratch buffers must hold a padded chunk");
+
+PaddedChunk::PaddedChunk()
+    : blocks(ChunkPools::meshScratch())
+{
+}
+
+void PaddedChunk::fill(const ChunkNeighborhood& neighborhood)
+{
+    // Each padded row is the last block of the -x neighbor, a full row of the middle chunk and the first block of the +x neighbor.
+    for (int z = -1; z <= CHUNK_SIZE; z++)
+    {
+        const int dz = z < 0 ? -1 : z >= CHUNK_SIZE ? 1 : 0;
+        const int lz = z - dz * CHUNK_SIZE;
+        for (int y = -1; y <= CHUNK_SIZE; y++)
+        {
+            const int dy = y < 0 ? -1 : y >= CHUNK_SIZE ? 1 : 0;
+            const int ly = y - dy * CHUNK_SIZE;
+            BlockID* row = blocks.get() + index(-1, y, z);
+
+            row[0] = neighborhood.at(-1, dy, dz).getBlock(CHUNK_SIZE - 1, ly, lz);
+            neighborhood.at(0, dy, dz).copyRow(ly, lz, row + 1);
+            row[CHUNK_SIZE + 1] = neighborhood.at(1, dy, dz).getBlock(0, ly, lz);
+        }
+    }
+
+    loadedNeighbors = 0;
+    for (int i = 0; i < (int)neighborhood.chunks.size(); i++)
+    {
+        if (neighborhood.chunks[i].isLoaded())
+            loadedNeighbors |= std::uint32_t(1) << i;
+    }
+
+    // Clamped so empty columns and columns topped far above the chunk stay in int range.
+    const int originY = neighborhood.center().coord.y * CHUNK_SIZE;
+    for (int i = 0; i < PADDED_AREA; i++)
+    {
+        const int height = neighborhood.surface[i];
+        surface[i] = height == HEIGHT_NONE ? -2 : std::min(std::max(height - originY, -2), CHUNK_SIZE);
+    }
+}
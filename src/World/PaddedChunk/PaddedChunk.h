@@ -0,0 +1,87 @@
+#ifndef PADDED_CHUNK_H
+#define PADDED_CHUNK_H
+
+#include <array>
+#include <cstdint>
+
+#include "../../Core/SlabPool/SlabPool.h"
+#include "../Block/Block.h"
+#include "../Chunk/Chunk.h"
+#include "../ChunkNeighborhood/ChunkNeighborhood.h"
+
+// Number of blocks along each axis of a padded chunk: the chunk plus a one block apron on both sides.
+constexpr int PADDED_SIZE = CHUNK_SIZE + 2;
+constexpr int PADDED_AREA = PADDED_SIZE * PADDED_SIZE;
+constexpr int PADDED_VOLUME = PADDED_AREA * PADDED_SIZE;
+
+/*
+ * A chunk's blocks plus a one block apron copied from its 26 neighbors, stored
+ * as one contiguous (CHUNK_SIZE + 2)^3 array in x-fastest order. Kernels can
+ * read every neighbor of every block in the chunk without bounds checks or
+ * chunk lookups. The buffer comes from the mesh scratch pool. The height of
+ * every padded column is kept alongside for sky light, along with which
+ * neighbors were loaded.
+ */
+class PaddedChunk
+{
+public:
+    // Constructor allocates the buffer; its contents are undefined until fill() is called.
+    PaddedChunk();
+
+    /**
+     * Copies a chunk and its apron out of a neighborhood snapshot.
+     *
+     * @param neighborhood The chunk to copy and its neighbors.
+     */
+    void fill(const ChunkNeighborhood& neighborhood);
+
+    /**
+     * Returns a block relative to the chunk's origin.
+     *
+     * @param x Local x-position, in [-1, CHUNK_SIZE].
+     * @param y Local y-position, in [-1, CHUNK_SIZE].
+     * @param z Local z-position, in [-1, CHUNK_SIZE].
+     * @return The ID of the block.
+     */
+    BlockID get(int x, int y, int z) const
+    {
+        return blocks[index(x, y, z)];
+    }
+
+    /**
+     * Returns the highest non-air block of a column relative to the chunk's origin; blocks above
+     * it are open to the sky.
+     *
+     * @param x Local x-position, in [-1, CHUNK_SIZE].
+     * @param z Local z-position, in [-1, CHUNK_SIZE].
+     * @return The local y-position, clamped to [-2, CHUNK_SIZE].
+     */
+    int getSurface(int x, int z) const
+    {
+        return surface[(x + 1) + (z + 1) * PADDED_SIZE];
+    }
+
+    // Returns true if the neighbor at the given offset, each in [-1, 1], was loaded when the chunk was filled.
+    bool isNeighborLoaded(int dx, int dy, int dz) const
+    {
+        return (loadedNeighbors >> ((dx + 1) + 3 * ((dy + 1) + 3 * (dz + 1))) & 1) != 0;
+    }
+
+    // Returns the padded block array.
+    const BlockID* data() const { return blocks.get(); }
+
+    // Returns the position of a block in the padded array, with local coordinates in [-1, CHUNK_SIZE].
+    static int index(int x, int y, int z)
+    {
+        return (x + 1) + PADDED_SIZE * ((y + 1) + PADDED_SIZE * (z + 1));
+    }
+
+private:
+    PoolBuffer<BlockID> blocks;
+    std::array<int, PADDED_AREA> surface;
+
+    // One bit per neighborhood snapshot that was loaded, in ChunkNeighborhood order.
+    std::uint32_t loadedNeighbors = 0;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include <algorithm>
+
+#include "PaddedLight.h"
+#include "../ChunkPools/ChunkPools.h"
+
+
+static_assert(MESH_LIGHT_BYTES >= PADDED_VOLUME, "mesh light buffers must hold a padded chunk");
+
+PaddedLight::PaddedLight()
+    : levels(ChunkPools::meshLight())
+{
+    queue.reserve(PADDED_VOLUME);
+}
+
+void PaddedLight::compute(const PaddedChunk& blocks, const std::uint8_t* opaque, const std::uint8_t* emission)
+{
+    const BlockID* data = blocks.data();
+    queue.clear();
+
+    // Seed the sky and the emitters. Only blocks brighter than 1 can light a neighbor, and a sky
+    // block only has neighbors darker than itself right above its column's surface or below the
+    // surface of a neighboring column, so the open air above the terrain is never queued.
+    for (int z = -1; z <= CHUNK_SIZE; z++)
+        for (int x = -1; x <= CHUNK_SIZE; x++)
+        {
+            const int surface = blocks.getSurface(x, z);
+            int reach = surface + 1;
+            if (x > -1)
+                reach = std::max(reach, blocks.getSurface(x - 1, z));
+            if (x < CHUNK_SIZE)
+                reach = std::max(reach, blocks.getSurface(x + 1, z));
+            if (z > -1)
+                reach = std::max(reach, blocks.getSurface(x, z - 1));
+            if (z < CHUNK_SIZE)
+                reach = std::max(reach, blocks.getSurface(x, z + 1));
+
+            for (int y = -1; y <= CHUNK_SIZE; y++)
+            {
+                const int i = PaddedChunk::index(x, y, z);
+                const BlockID block = data[i];
+                const bool sky = !opaque[block] && y > surface;
+                levels[i] = sky ? LIGHT_MAX : emission[block];
+                if (sky ? y <= reach : levels[i] > 1)
+                    queue.push_back(i);
+            }
+        }
+
+    // Spread in queue order; a block is queued again whenever a brighter path reaches it.
+    const int strides[3] = { 1, PADDED_SIZE, PADDED_AREA };
+    for (std::size_t next = 0; next < queue.size(); next++)
+    {
+        const int i = queue[next];
+        const std::uint8_t spread = levels[i] - 1;
+        const int position[3] = { i % PADDED_SIZE, (i / PADDED_SIZE) % PADDED_SIZE, i / PADDED_AREA };
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (int direction = -1; direction <= 1; direction += 2)
+            {
+                const int p = position[axis] + direction;
+                if (p < 0 || p >= PADDED_SIZE)
+                    continue;
+
+                const int neighbor = i + direction * strides[axis];
+                if (opaque[data[neighbor]] || levels[neighbor] >= spread)
+                    continue;
+
+                levels[neighbor] = spread;
+                if (spread > 1)
+                    queue.push_back(neighbor);
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef PADDED_LIGHT_H
+#define PADDED_LIGHT_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../../Core/SlabPool/SlabPool.h"
+#include "../PaddedChunk/PaddedChunk.h"
+
+// Highest light level, of open sky and of the brightest emitters.
+constexpr std::uint8_t LIGHT_MAX = 15;
+
+/*
+ * Light level of every block of a padded chunk, combining sky light and block
+ * light into one channel by taking the brighter of the two. Blocks above their
+ * column's surface get full sky light, emitters get their emission, and both
+ * spread through non-opaque blocks with a breadth-first fill, losing one level
+ * per block.
+ *
+ * The fill only sees the padded chunk, so light that would enter from more
+ * than one block outside the chunk, such as sky light reaching deep under an
+ * overhang of the next chunk, is missed. Mesh jobs compute it from their own
+ * snapshot so lighting never waits on the main thread. The light buffer comes
+ * from the mesh light pool.
+ */
+class PaddedLight
+{
+public:
+    // Constructor allocates the light and queue buffers.
+    PaddedLight();
+
+    /**
+     * Lights a padded chunk.
+     *
+     * @param blocks The chunk and its apron, with column surfaces.
+     * @param opaque Opacity of every block ID, 1 for opaque blocks.
+     * @param emission Light emission of every block ID, in [0, LIGHT_MAX].
+     */
+    void compute(const PaddedChunk& blocks, const std::uint8_t* opaque, const std::uint8_t* emission);
+
+    // Returns the light levels in the padded array's order.
+    const std::uint8_t* data() const { return levels.get(); }
+
+    /**
+     * Returns the light level of a block.
+     *
+     * @param x Local x-position, in [-1, CHUNK_SIZE].
+     * @param y Local y-position, in [-1, CHUNK_SIZE].
+     * @param z Local z-position, in [-1, CHUNK_SIZE].
+     * @return The light level, in [0, LIGHT_MAX].
+     */
+    std::uint8_t get(int x, int y, int z) const { return levels[PaddedChunk::index(x, y, z)]; }
+
+private:
+    PoolBuffer<std::uint8_t> levels;
+
+    // Padded indices of blocks whose light still has to spread to their neighbors.
+    std::vector<int> queue;
+};
+
+#endif
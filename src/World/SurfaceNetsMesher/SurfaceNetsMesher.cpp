@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cmath>
+
+#include "SurfaceNetsMesher.h"
+#include "../ChunkMesher/ChunkMesher.h"
+#include "../../Core/Bits/Bits.h"
+
+static_assert(PADDED_SIZE <= 64, "surface nets store a padded row of samples in one 64-bit word");
+
+// Padded array stride of each axis.
+static const int AXIS_STRIDES[3] = { 1, PADDED_SIZE, PADDED_AREA };
+
+std::uint32_t packSurfaceAttributes(std::uint16_t tile, std::uint8_t light, float nx, float ny, float nz)
+{
+    // Project the normal onto the octahedron |x| + |y| + |z| = 1 and fold the lower half over the upper.
+    const float length = std::fabs(nx) + std::fabs(ny) + std::fabs(nz);
+    float u = nx / length;
+    float v = ny / length;
+    if (nz < 0.0f)
+    {
+        const float foldedU = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        v = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = foldedU;
+    }
+    const std::uint32_t encodedU = (std::uint32_t)std::lround((u * 0.5f + 0.5f) * 255.0f);
+    const std::uint32_t encodedV = (std::uint32_t)std::lround((v * 0.5f + 0.5f) * 255.0f);
+
+    return (std::uint32_t)tile | (std::uint32_t)light << SURFACE_LIGHT_SHIFT
+        | (encodedU | encodedV << 8) << SURFACE_NORMAL_SHIFT;
+}
+
+SurfaceNetsMesher::SurfaceNetsMesher()
+{
+    const BlockRegistry& registry = BlockRegistry::instance();
+    const std::size_t count = registry.getBlockCount();
+    opaque.assign(registry.getOpacityTable(), registry.getOpacityTable() + count);
+    emission.assign(registry.getEmissionTable(), registry.getEmissionTable() + count);
+
+    // A tile the attributes have no room for falls back to the first one.
+    topTiles.resize(count);
+    for (std::size_t block = 0; block < count; block++)
+    {
+        const std::uint16_t tile = registry.getTile((BlockID)block, BlockFace::PosY);
+        topTiles[block] = tile < SURFACE_MAX_TILES ? tile : 0;
+    }
+}
+
+void SurfaceNetsMesher::mesh(const PaddedChunk& blocks, std::vector<SurfaceVertex>& vertices,
+                             std::vector<std::uint32_t>& indices) const
+{
+    thread_local std::vector<float> densityBuffer(PADDED_VOLUME);
+    float* density = densityBuffer.data();
+    const BlockID* data = blocks.data();
+    for (int i = 0; i < PADDED_VOLUME; i++)
+        density[i] = opaque[data[i]] ? 1.0f : -1.0f;
+
+    thread_local PaddedLight light;
+    light.compute(blocks, opaque.data(), emission.data());
+
+    mesh(density, blocks, light.data(), vertices, indices);
+}
+
+void SurfaceNetsMesher::mesh(const float* density, const PaddedChunk& blocks, const std::uint8_t* light,
+                             std::vector<SurfaceVertex>& vertices, std::vector<std::uint32_t>& indices) const
+{
+    vertices.clear();
+    indices.clear();
+
+    // Index of each cell's vertex, -1 until a quad first needs it, so cells whose edges all belong
+    // to neighboring chunks never get one.
+    thread_local std::vector<int> cellBuffer(SURFACE_CELL_SIZE * SURFACE_CELL_SIZE * SURFACE_CELL_SIZE);
+    std::fill(cellBuffer.begin(), cellBuffer.end(), -1);
+    int* cellVertices = cellBuffer.data();
+    auto vertexOf = [&](const int cell[3]) {
+        int& vertex = cellVertices[cell[0] + SURFACE_CELL_SIZE * (cell[1] + SURFACE_CELL_SIZE * cell[2])];
+        if (vertex < 0)
+        {
+            vertex = (int)vertices.size();
+            vertices.push_back(cellVertex(density, blocks, light, cell));
+        }
+        return (std::uint32_t)vertex;
+    };
+
+    // Bit x of row (y, z) is set where the sample at padded (x, y, z) is inside, so the edges the surface
+    // crosses are the bits that differ from the next sample along each axis.
+    std::uint64_t rows[PADDED_AREA];
+    for (int row = 0; row < PADDED_AREA; row++)
+    {
+        const float* samples = density + row * PADDED_SIZE;
+        std::uint64_t inside = 0;
+        for (int x = 0; x < PADDED_SIZE; x++)
+            inside |= (std::uint64_t)(samples[x] > 0.0f) << x;
+        rows[row] = inside;
+    }
+
+    // Edges leading into the chunk from an unloaded -x, -y or -z neighbor have no other owner, so the
+    // chunk takes them too: along x from sample 0, and along y and z from the apron rows below.
+    const bool openX = !blocks.isNeighborLoaded(-1, 0, 0);
+    const bool openY = !blocks.isNeighborLoaded(0, -1, 0);
+    const bool openZ = !blocks.isNeighborLoaded(0, 0, -1);
+    const std::uint64_t owned = ((std::uint64_t(1) << CHUNK_SIZE) - 1) << 1;
+    for (int z = openZ ? 0 : 1; z <= CHUNK_SIZE; z++)
+        for (int y = openY ? 0 : 1; y <= CHUNK_SIZE; y++)
+        {
+            const std::uint64_t row = rows[y + z * PADDED_SIZE];
+            const std::uint64_t crossed[3] = {
+                row ^ (row >> 1),
+                row ^ rows[(y + 1) + z * PADDED_SIZE],
+                row ^ rows[y + (z + 1) * PADDED_SIZE],
+            };
+            const std::uint64_t ownedEdges[3] = {
+                y > 0 && z > 0 ? owned | (openX ? 1 : 0) : 0,
+                z > 0 ? owned : 0,
+                y > 0 ? owned : 0,
+            };
+            for (int normal = 0; normal < 3; normal++)
+            {
+                std::uint64_t edges = crossed[normal] & ownedEdges[normal];
+                while (edges)
+                {
+                    const int x = countTrailingZeros(edges);
+                    edges &= edges - 1;
+                    const bool inside = (row >> x & 1) != 0;
+
+                    // The four cells around the edge, counter-clockwise seen from the edge's positive end.
+                    const int axisA = (normal + 1) % 3;
+                    const int axisB = (normal + 2) % 3;
+                    int cells[4][3];
+                    for (int i = 0; i < 4; i++)
+                    {
+                        cells[i][0] = x;
+                        cells[i][1] = y;
+                        cells[i][2] = z;
+                    }
+                    cells[0][axisA]--;
+                    cells[0][axisB]--;
+                    cells[1][axisB]--;
+                    cells[3][axisA]--;
+
+                    // Face away from the inside, which is the edge's negative end when the start is inside.
+                    std::uint32_t quad[4];
+                    for (int i = 0; i < 4; i++)
+                        quad[i] = vertexOf(cells[inside ? i : (4 - i) % 4]);
+
+                    // Split along the shorter diagonal, so the triangles follow the surface's curvature.
+                    const float* p0 = vertices[quad[0]].position;
+                    const float* p1 = vertices[quad[1]].position;
+                    const float* p2 = vertices[quad[2]].position;
+                    const float* p3 = vertices[quad[3]].position;
+                    float diagonal02 = 0.0f;
+                    float diagonal13 = 0.0f;
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        diagonal02 += (p2[axis] - p0[axis]) * (p2[axis] - p0[axis]);
+                        diagonal13 += (p3[axis] - p1[axis]) * (p3[axis] - p1[axis]);
+                    }
+                    const int first = diagonal02 <= diagonal13 ? 0 : 1;
+                    for (std::uint32_t corner : QUAD_INDEX_PATTERN)
+                        indices.push_back(quad[(first + corner) % 4]);
+                }
+            }
+        }
+}
+
+SurfaceVertex SurfaceNetsMesher::cellVertex(const float* density, const PaddedChunk& blocks, const std::uint8_t* light,
+                                            const int cell[3]) const
+{
+    // Corner i of the cell is offset by bit 0 of i along x, bit 1 along y and bit 2 along z.
+    const int base = cell[0] + PADDED_SIZE * (cell[1] + PADDED_SIZE * cell[2]);
+    int samples[8];
+    float values[8];
+    for (int i = 0; i < 8; i++)
+    {
+        samples[i] = base + (i & 1) * AXIS_STRIDES[0] + (i >> 1 & 1) * AXIS_STRIDES[1] + (i >> 2 & 1) * AXIS_STRIDES[2];
+        values[i] = density[samples[i]];
+    }
+
+    // Average the points where the surface crosses the cell's edges, interpolating the density linearly along each.
+    float sum[3] = { 0.0f, 0.0f, 0.0f };
+    int crossings = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const int j = i | 1 << axis;
+            if (j == i || (values[i] > 0.0f) == (values[j] > 0.0f))
+                continue;
+
+            const float t = values[i] / (values[i] - values[j]);
+            for (int k = 0; k < 3; k++)
+                sum[k] += (float)(i >> k & 1) + (k == axis ? t : 0.0f);
+            crossings++;
+        }
+    }
+
+    // Samples sit at block centers, half a block past the local position of their padded index minus one.
+    SurfaceVertex vertex;
+    for (int k = 0; k < 3; k++)
+        vertex.position[k] = (float)cell[k] - 0.5f + sum[k] / (float)crossings;
+
+    // The normal points down the density gradient, out of the terrain.
+    float gradient[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 8; i++)
+    {
+        for (int axis = 0; axis < 3; axis++)
+            gradient[axis] += (i >> axis & 1) ? values[i] : -values[i];
+    }
+    if (gradient[0] == 0.0f && gradient[1] == 0.0f && gradient[2] == 0.0f)
+        gradient[1] = -1.0f;
+
+    // Take the tile of the highest block inside the terrain, so grass covers slopes, and light the vertex
+    // with the average of the blocks outside it.
+    const BlockID* data = blocks.data();
+    int tileCorner = -1;
+    int lightSum = 0;
+    int outside = 0;
+    for (int i = 7; i >= 0; i--)
+    {
+        if (values[i] > 0.0f)
+        {
+            if (tileCorner < 0 || (i >> 1 & 1) > (tileCorner >> 1 & 1))
+                tileCorner = i;
+        }
+        else
+        {
+            lightSum += light[samples[i]];
+            outside++;
+        }
+    }
+    const std::uint16_t tile = topTiles[data[samples[tileCorner]]];
+    const std::uint8_t level = (std::uint8_t)((lightSum + outside / 2) / outside);
+
+    vertex.attributes = packSurfaceAttributes(tile, level, -gradient[0], -gradient[1], -gradient[2]);
+    return vertex;
+}
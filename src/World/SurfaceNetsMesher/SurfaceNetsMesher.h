@@ -0,0 +1,122 @@
+#ifndef SURFACE_NETS_MESHER_H
+#define SURFACE_NETS_MESHER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../Block/Block.h"
+#include "../BlockRegistry/BlockRegistry.h"
+#include "../PaddedChunk/PaddedChunk.h"
+#include "../PaddedLight/PaddedLight.h"
+
+/*
+ * Vertex of a smooth terrain mesh: the position relative to the chunk's origin,
+ * between -0.5 and CHUNK_SIZE + 0.5, and one packed word of attributes unpacked
+ * by the surface shader.
+ *
+ * attributes: atlas tile in bits 0-11, light in bits 12-15, and the normal in
+ *             bits 16-31, octahedral encoded with 8 bits per coordinate.
+ */
+struct SurfaceVertex
+{
+    float position[3];
+    std::uint32_t attributes;
+};
+
+constexpr int SURFACE_LIGHT_SHIFT = 12;
+constexpr int SURFACE_NORMAL_SHIFT = 16;
+constexpr std::size_t SURFACE_MAX_TILES = std::size_t(1) << SURFACE_LIGHT_SHIFT;
+
+// Number of surface nets cells along each axis of a padded chunk, one between each pair of neighboring samples.
+constexpr int SURFACE_CELL_SIZE = PADDED_SIZE - 1;
+
+/**
+ * Packs the attributes of a surface vertex.
+ *
+ * @param tile The atlas tile, below SURFACE_MAX_TILES.
+ * @param light Light level, in [0, LIGHT_MAX].
+ * @param nx Normal x-component.
+ * @param ny Normal y-component.
+ * @param nz Normal z-component.
+ * @return The packed attributes.
+ */
+std::uint32_t packSurfaceAttributes(std::uint16_t tile, std::uint8_t light, float nx, float ny, float nz);
+
+/*
+ * Builds smooth terrain meshes with naive surface nets. The density field is
+ * sampled at block centers of the padded chunk, positive inside the terrain.
+ * Every cell between eight samples that the surface crosses gets one vertex,
+ * at the average of the points where the surface crosses its edges, and every
+ * sample edge the surface crosses becomes a quad joining the vertices of the
+ * four cells around it. Vertices are shared by all the quads around them, so
+ * the mesh is indexed, and it has fewer and better shaped triangles than
+ * marching cubes would give.
+ *
+ * A chunk owns the edges that start at one of its own samples, which keeps
+ * the meshes of neighboring chunks from overlapping, and the edges that lead
+ * into it from an unloaded -x, -y or -z neighbor, which nothing else meshes.
+ * The cells around them reach one sample into the apron, so the padded chunk
+ * holds everything a chunk's mesh needs, and meshes of neighbors join without
+ * cracks. Loading or unloading a chunk changes what its neighbors own, so
+ * they have to be meshed again.
+ *
+ * Without a density field, mesh() derives one from the blocks, +1 for opaque
+ * blocks and -1 otherwise, which puts every crossing halfway between block
+ * centers and rounds off the corners of the cube terrain.
+ */
+class SurfaceNetsMesher
+{
+public:
+    // Constructor caches the opacity, emission and top tiles of every block. Blocks registered
+    // afterwards are not picked up.
+    SurfaceNetsMesher();
+
+    /**
+     * Meshes a chunk with a density field derived from its blocks. Safe to call from several
+     * threads at once.
+     *
+     * @param blocks The chunk and its apron.
+     * @param vertices Receives the mesh's vertices; cleared first.
+     * @param indices Receives three indices into vertices per triangle, counter-clockwise seen
+     *                from outside the terrain; cleared first.
+     */
+    void mesh(const PaddedChunk& blocks, std::vector<SurfaceVertex>& vertices, std::vector<std::uint32_t>& indices) const;
+
+    /**
+     * Meshes a chunk from a density field. Safe to call from several threads at once.
+     *
+     * @param density Density at every block center of the padded chunk, in the padded array's order,
+     *                positive inside the terrain.
+     * @param blocks The chunk and its apron, which give the tiles.
+     * @param light Light level of every block of the padded chunk.
+     * @param vertices Receives the mesh's vertices; cleared first.
+     * @param indices Receives three indices into vertices per triangle, counter-clockwise seen
+     *                from outside the terrain; cleared first.
+     */
+    void mesh(const float* density, const PaddedChunk& blocks, const std::uint8_t* light,
+              std::vector<SurfaceVertex>& vertices, std::vector<std::uint32_t>& indices) const;
+
+private:
+    // Opacity of every block ID, from the block registry.
+    std::vector<std::uint8_t> opaque;
+
+    // Light emitted by every block ID, from the block registry.
+    std::vector<std::uint8_t> emission;
+
+    // Atlas tile of the top face of every block ID, 0 for tiles not below SURFACE_MAX_TILES.
+    std::vector<std::uint16_t> topTiles;
+
+    /**
+     * Builds the vertex of a cell the surface crosses.
+     *
+     * @param density The padded density field.
+     * @param blocks The chunk and its apron.
+     * @param light The padded light levels.
+     * @param cell Padded position of the cell's minimum sample.
+     * @return The vertex.
+     */
+    SurfaceVertex cellVertex(const float* density, const PaddedChunk& blocks, const std::uint8_t* light,
+                             const int cell[3]) const;
+};
+
+#endif
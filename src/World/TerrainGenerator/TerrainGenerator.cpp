@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "TerrainGenerator.h"
+
+TerrainGenerator::TerrainGenerator(int seed)
+    : offsetX((float)(seed % 10007) * 17.31f), offsetZ((float)(seed % 10009) * 29.77f)
+{
+}
+
+int TerrainGenerator::getSurfaceHeight(int x, int z) const
+{
+    const float fx = (float)x + offsetX;
+    const float fz = (float)z + offsetZ;
+
+    // Broad mountain ranges hundreds of blocks tall with rolling hills on top.
+    const float mountains = 400.0f * std::sin(fx * 0.0021f) * std::cos(fz * 0.0017f);
+    const float hills = 24.0f * std::sin(fx * 0.021f + fz * 0.013f) + 12.0f * std::cos(fz * 0.037f - fx * 0.011f);
+    const float detail = 3.0f * std::sin(fx * 0.13f) * std::cos(fz * 0.11f);
+    return (int)std::floor(mountains + hills + detail);
+}
+
+void TerrainGenerator::generate(World& world, ChunkCoord coord) const
+{
+    std::array<int, CHUNK_AREA> heights;
+    int lowest = std::numeric_limits<int>::max();
+    int highest = std::numeric_limits<int>::min();
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int x = 0; x < CHUNK_SIZE; x++)
+        {
+            const int height = getSurfaceHeight(coord.x * CHUNK_SIZE + x, coord.z * CHUNK_SIZE + z);
+            heights[x + z * CHUNK_SIZE] = height;
+            lowest = std::min(lowest, height);
+            highest = std::max(highest, height);
+        }
+
+    const int chunkBottom = coord.y * CHUNK_SIZE;
+    if (chunkBottom > highest)
+        return;
+
+    std::vector<BlockID> blocks(SECTION_VOLUME);
+    for (int s = 0; s < SECTIONS_PER_CHUNK; s++)
+    {
+        const int sx = (s % SECTIONS_PER_AXIS) * SECTION_SIZE;
+        const int sy = ((s / SECTIONS_PER_AXIS) % SECTIONS_PER_AXIS) * SECTION_SIZE;
+        const int sz = (s / (SECTIONS_PER_AXIS * SECTIONS_PER_AXIS)) * SECTION_SIZE;
+        const int sectionBottom = chunkBottom + sy;
+        const int sectionTop = sectionBottom + SECTION_SIZE - 1;
+        if (sectionBottom > highest)
+            continue;
+
+        // Below every surface block in the chunk, so the section is solid dirt.
+        if (sectionTop < lowest)
+        {
+            world.editSection(coord, s, [](ChunkSection& section) {
+                section.fill(BLOCK_DIRT);
+                return true;
+            });
+            continue;
+        }
+
+        bool empty = true;
+        for (int z = 0; z < SECTION_SIZE; z++)
+            for (int y = 0; y < SECTION_SIZE; y++)
+                for (int x = 0; x < SECTION_SIZE; x++)
+                {
+                    const int height = heights[(sx + x) + (sz + z) * CHUNK_SIZE];
+                    const int worldY = sectionBottom + y;
+                    const BlockID block = worldY < height ? BLOCK_DIRT : worldY == height ? BLOCK_GRASS : BLOCK_AIR;
+                    blocks[x + SECTION_SIZE * (y + SECTION_SIZE * z)] = block;
+                    empty = empty && block == BLOCK_AIR;
+                }
+
+        if (empty)
+            continue;
+
+        world.editSection(coord, s, [&](ChunkSection& section) {
+            section.assign(blocks.data());
+            return true;
+        });
+    }
+}
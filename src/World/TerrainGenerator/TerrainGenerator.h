@@ -0,0 +1,47 @@
+#ifndef TERRAIN_GENERATOR_H
+#define TERRAIN_GENERATOR_H
+
+#include "../Chunk/Chunk.h"
+#include "../World/World.h"
+
+/*
+ * Generates terrain one cubic chunk at a time from a 2D surface height
+ * function, so any chunk can be generated without its column: chunks above
+ * the surface cost a height evaluation per column and nothing else, and
+ * sections entirely below it become uniform without per-block work.
+ */
+class TerrainGenerator
+{
+public:
+    /**
+     * Constructor creates a generator.
+     *
+     * @param seed Seed that offsets the height function, different seeds give different terrain.
+     */
+    explicit TerrainGenerator(int seed = 0);
+
+    /**
+     * Returns the height of the terrain surface.
+     *
+     * @param x World x-position.
+     * @param z World z-position.
+     * @return The world y-position of the top (grass) block of the column.
+     */
+    int getSurfaceHeight(int x, int z) const;
+
+    /**
+     * Writes the terrain of one chunk into the world through its batched section writes.
+     * Chunks entirely above the surface are left unloaded, since they are all air.
+     *
+     * @param world The world to write to.
+     * @param coord The chunk coordinate to generate.
+     */
+    void generate(World& world, ChunkCoord coord) const;
+
+private:
+    // Phase offsets derived from the seed.
+    float offsetX;
+    float offsetZ;
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef RAYCAST_H
+#define RAYCAST_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <../include/glm/glm.hpp>
+
+#include "VoxelStorage.h"
+
+/**
+ * Walks a ray through a hierarchical storage one homogeneous leaf at a time, so empty
+ * regions are crossed in a single step regardless of their size.
+ *
+ * @param rayOrigin Start of the ray in world space.
+ * @param direction Direction of the ray (does not need to be normalized).
+ * @param maxDistance Maximum distance along the ray, in units of the direction's length.
+ * @param boundsMin Minimum corner of the storage's cubic region.
+ * @param boundsSize Number of blocks along each axis of the region.
+ * @param findLeaf Called as findLeaf(glm::ivec3 cell, glm::ivec3& leafMin, int& leafSize) and returns
+ *                 the block filling the axis-aligned leaf containing the cell.
+ * @param hit Receives the hit information.
+ * @return True if a non-air block was hit.
+ */
+template <typename FindLeaf>
+bool traverseLeaves(glm::vec3 rayOrigin, glm::vec3 direction, float maxDistance,
+    glm::ivec3 boundsMin, int boundsSize, FindLeaf&& findLeaf, RaycastHit& hit)
+{
+    const glm::dvec3 start(rayOrigin);
+    const glm::dvec3 dir(direction);
+    const glm::ivec3 boundsMax = boundsMin + boundsSize;
+
+    // Clip the ray against the region.
+    double tEnter = 0.0, tLeave = maxDistance;
+    int enterAxis = -1;
+    for (int a = 0; a < 3; a++)
+    {
+        if (dir[a] == 0.0)
+        {
+            if (start[a] < boundsMin[a] || start[a] >= boundsMax[a])
+                return false;
+            continue;
+        }
+        double t0 = (boundsMin[a] - start[a]) / dir[a];
+        double t1 = (boundsMax[a] - start[a]) / dir[a];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        if (t0 > tEnter)
+        {
+            tEnter = t0;
+            enterAxis = a;
+        }
+        tLeave = std::min(tLeave, t1);
+    }
+    if (tEnter > tLeave)
+        return false;
+
+    glm::ivec3 cell;
+    glm::ivec3 normal(0);
+    const glm::dvec3 entry = start + dir * tEnter;
+    for (int a = 0; a < 3; a++)
+        cell[a] = glm::clamp((int)std::floor(entry[a]), boundsMin[a], boundsMax[a] - 1);
+    if (enterAxis >= 0)
+    {
+        cell[enterAxis] = dir[enterAxis] > 0.0 ? boundsMin[enterAxis] : boundsMax[enterAxis] - 1;
+        normal[enterAxis] = dir[enterAxis] > 0.0 ? -1 : 1;
+    }
+
+    // Step from leaf to leaf, each iteration leaving the current leaf through its nearest exit face.
+    double t = tEnter;
+    while (glm::all(glm::greaterThanEqual(cell, boundsMin)) && glm::all(glm::lessThan(cell, boundsMax)))
+    {
+        glm::ivec3 leafMin;
+        int leafSize;
+        const BlockID block = findLeaf(cell, leafMin, leafSize);
+        if (block != BLOCK_AIR)
+        {
+            hit = RaycastHit{ cell, normal, (float)t, block };
+            return true;
+        }
+
+        int exitAxis = 0;
+        double tExit = std::numeric_limits<double>::infinity();
+        for (int a = 0; a < 3; a++)
+        {
+            if (dir[a] == 0.0)
+                continue;
+            const double boundary = dir[a] > 0.0 ? leafMin[a] + leafSize : leafMin[a];
+            const double ta = (boundary - start[a]) / dir[a];
+            if (ta < tExit)
+            {
+                tExit = ta;
+                exitAxis = a;
+            }
+        }
+        if (tExit > maxDistance)
+            return false;
+
+        t = tExit;
+        const glm::dvec3 p = start + dir * t;
+        for (int a = 0; a < 3; a++)
+            cell[a] = glm::clamp((int)std::floor(p[a]), leafMin[a], leafMin[a] + leafSize - 1);
+        cell[exitAxis] = dir[exitAxis] > 0.0 ? leafMin[exitAxis] + leafSize : leafMin[exitAxis] - 1;
+        normal = glm::ivec3(0);
+        normal[exitAxis] = dir[exitAxis] > 0.0 ? -1 : 1;
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,19 @@
+#include "VoxelStorage.h"
+#include "../World/World.h"
+#include "../Octree/Octree.h"
+#include "../Brickmap/Brickmap.h"
+
+
+std::unique_ptr<VoxelStorage> createVoxelStorage(WorldStorageType type)
+{
+    switch (type)
+    {
+    case WorldStorageType::Octree:
+        return std::make_unique<Octree>();
+    case WorldStorageType::Brickmap:
+        return std::make_unique<Brickmap>();
+    case WorldStorageType::Chunks:
+    default:
+        return std::make_unique<World>();
+    }
+}
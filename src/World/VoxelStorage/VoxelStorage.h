@@ -0,0 +1,76 @@
+#ifndef VOXEL_STORAGE_H
+#define VOXEL_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+
+#include <../include/glm/glm.hpp>
+
+#include "../Block/Block.h"
+
+// The backends a world can store its blocks in.
+enum class WorldStorageType
+{
+    Chunks,
+    Octree,
+    Brickmap
+};
+
+// Result of a ray traversal.
+struct RaycastHit
+{
+    // Position of the block that was hit.
+    glm::ivec3 position;
+
+    // Normal of the face the ray entered the block through.
+    glm::ivec3 normal;
+
+    // Distance along the ray to the hit, in units of the ray direction's length.
+    float distance;
+
+    // ID of the block that was hit.
+    BlockID block;
+};
+
+/*
+ * Block accessor interface shared by every world storage backend, so a world
+ * can be switched between backends and the backends can be compared directly.
+ */
+class VoxelStorage
+{
+public:
+    virtual ~VoxelStorage() = default;
+
+    /**
+     * Returns the block at the given world position.
+     *
+     * @param x World x-position.
+     * @param y World y-position.
+     * @param z World z-position.
+     * @return The ID of the block, or air outside the stored region.
+     */
+    virtual BlockID getBlock(int x, int y, int z) const = 0;
+
+    /**
+     * Sets the block at the given world position.
+     *
+     * @param x World x-position.
+     * @param y World y-position.
+     * @param z World z-position.
+     * @param block The ID of the new block.
+     */
+    virtual void setBlock(int x, int y, int z, BlockID block) = 0;
+
+    // Returns the approximate number of heap bytes used to store the blocks.
+    virtual std::size_t memoryUsage() const = 0;
+};
+
+/**
+ * Creates an empty world storage of the given type.
+ *
+ * @param type The storage backend to use.
+ * @return The new storage.
+ */
+std::unique_ptr<VoxelStorage> createVoxelStorage(WorldStorageType type);
+
+#endif
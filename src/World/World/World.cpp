@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <cmath>
+
+#include "World.h"
+
+Chunk* World::getChunk(ChunkCoord coord)
+{
+    std::unique_ptr<Chunk>* chunk = chunks.find(coord);
+    return chunk ? chunk->get() : nullptr;
+}
+
+const Chunk* World::getChunk(ChunkCoord coord) const
+{
+    const std::unique_ptr<Chunk>* chunk = chunks.find(coord);
+    return chunk ? chunk->get() : nullptr;
+}
+
+Chunk& World::createChunk(ChunkCoord coord)
+{
+    std::unique_ptr<Chunk>& chunk = chunks[coord];
+    if (!chunk)
+    {
+        chunk = std::make_unique<Chunk>(coord);
+
+        std::unique_ptr<Heightmap>& heightmap = heightmaps[columnOf(coord)];
+        if (!heightmap)
+            heightmap = std::make_unique<Heightmap>();
+        heightmap->addChunk(coord.y);
+    }
+    return *chunk;
+}
+
+void World::removeChunk(ChunkCoord coord)
+{
+    if (!chunks.erase(coord))
+        return;
+    unloadedChunks.push_back(coord);
+
+    Heightmap& heightmap = **heightmaps.find(columnOf(coord));
+    if (heightmap.removeChunk())
+    {
+        heightmaps.erase(columnOf(coord));
+        return;
+    }
+
+    // Columns topped inside the unloaded chunk fall back to the loaded chunks below it, which now see the sky.
+    const int bottom = coord.y * CHUNK_SIZE;
+    for (int z = 0; z < CHUNK_SIZE; z++)
+        for (int x = 0; x < CHUNK_SIZE; x++)
+        {
+            const int height = heightmap.get(x, z);
+            if (height >= bottom && height < bottom + CHUNK_SIZE)
+            {
+                const int worldX = coord.x * CHUNK_SIZE + x;
+                const int worldZ = coord.z * CHUNK_SIZE + z;
+                setHeight(heightmap, worldX, worldZ, scanDown(worldX, bottom - 1, worldZ, heightmap));
+            }
+        }
+}
+
+BlockID World::getBlock(int x, int y, int z) const
+{
+    const Chunk* chunk = getChunk(toChunkCoord(x, y, z));
+    if (!chunk)
+        return BLOCK_AIR;
+    return chunk->getBlock(toLocal(x), toLocal(y), toLocal(z));
+}
+
+void World::setBlock(int x, int y, int z, BlockID block)
+{
+    const ChunkCoord coord = toChunkCoord(x, y, z);
+    Chunk* chunk = getChunk(coord);
+    if (!chunk)
+    {
+        if (block == BLOCK_AIR)
+            return;
+        chunk = &createChunk(coord);
+    }
+    if (chunk->getBlock(toLocal(x), toLocal(y), toLocal(z)) == block)
+        return;
+
+    if (chunk->getDirtySections() == 0)
+        dirtyChunks.push_back(coord);
+    chunk->setBlock(toLocal(x), toLocal(y), toLocal(z), block);
+    updateHeight(x, y, z, block);
+}
+
+template <typename Fn>
+void World::forEachSectionInBox(glm::ivec3 min, glm::ivec3 max, bool create, Fn&& fn)
+{
+    if (glm::any(glm::greaterThanEqual(min, max)))
+        return;
+
+    const ChunkCoord first = toChunkCoord(min.x, min.y, min.z);
+    const ChunkCoord last = toChunkCoord(max.x - 1, max.y - 1, max.z - 1);
+    for (int cz = first.z; cz <= last.z; cz++)
+        for (int cy = first.y; cy <= last.y; cy++)
+            for (int cx = first.x; cx <= last.x; cx++)
+            {
+                const ChunkCoord coord{ cx, cy, cz };
+                Chunk* chunk = create ? &createChunk(coord) : getChunk(coord);
+                if (!chunk)
+                    continue;
+
+                for (int s = 0; s < SECTIONS_PER_CHUNK; s++)
+                {
+                    const glm::ivec3 origin = sectionOrigin(coord, s);
+                    const glm::ivec3 localMin = glm::max(min - origin, glm::ivec3(0));
+                    const glm::ivec3 localMax = glm::min(max - origin, glm::ivec3(SECTION_SIZE));
+                    if (glm::any(glm::greaterThanEqual(localMin, localMax)))
+                        continue;
+
+                    if (fn(*chunk, s, localMin, localMax, origin))
+                        sectionEdited(*chunk, s, localMin, localMax);
+                }
+            }
+}
+
+void World::fillBox(glm::ivec3 min, glm::ivec3 max, BlockID block)
+{
+    forEachSectionInBox(min, max, block != BLOCK_AIR,
+        [&](Chunk& chunk, int section, glm::ivec3 localMin, glm::ivec3 localMax, glm::ivec3) {
+            const ChunkSection& current = chunk.getSection(section);
+            if (current.isUniform() && current.getUniformBlock() == block)
+                return false;
+            return chunk.mutableSection(section).fillBox(localMin, localMax, block);
+        });
+}
+
+void World::replaceBox(glm::ivec3 min, glm::ivec3 max, BlockID from, BlockID to)
+{
+    // Unloaded chunks are all air, so they only need creating when air is being replaced.
+    forEachSectionInBox(min, max, from == BLOCK_AIR && to != BLOCK_AIR,
+        [&](Chunk& chunk, int section, glm::ivec3 localMin, glm::ivec3 localMax, glm::ivec3) {
+            if (!chunk.getSection(section).contains(from))
+                return false;
+            return chunk.mutableSection(section).replaceInBox(localMin, localMax, from, to);
+        });
+}
+
+void World::fillSphere(glm::vec3 center, float radius, BlockID block)
+{
+    const glm::ivec3 min(glm::floor(center - radius));
+    const glm::ivec3 max = glm::ivec3(glm::ceil(center + radius)) + 1;
+    const float radiusSquared = radius * radius;
+
+    forEachSectionInBox(min, max, block != BLOCK_AIR,
+        [&](Chunk& chunk, int section, glm::ivec3 localMin, glm::ivec3 localMax, glm::ivec3 sectionOrigin) {
+            const ChunkSection& current = chunk.getSection(section);
+            if (current.isUniform() && current.getUniformBlock() == block)
+                return false;
+            return chunk.mutableSection(section).fillWhere(localMin, localMax, block, [&](int x, int y, int z) {
+                const glm::vec3 offset = glm::vec3(sectionOrigin + glm::ivec3(x, y, z)) + 0.5f - center;
+                return glm::dot(offset, offset) <= radiusSquared;
+            });
+        });
+}
+
+std::vector<DirtyChunk> World::takeDirtyChunks()
+{
+    std::vector<DirtyChunk> result;
+    result.reserve(dirtyChunks.size());
+    for (const ChunkCoord& coord : dirtyChunks)
+    {
+        Chunk* chunk = getChunk(coord);
+        if (!chunk || chunk->getDirtySections() == 0)
+            continue;
+        result.push_back(DirtyChunk{ coord, chunk->getDirtySections() });
+        chunk->clearDirtySections();
+    }
+    dirtyChunks.clear();
+    return result;
+}
+
+std::vector<ChunkCoord> World::takeUnloadedChunks()
+{
+    std::vector<ChunkCoord> result;
+    result.swap(unloadedChunks);
+    return result;
+}
+
+void World::markDirty(Chunk& chunk, int section)
+{
+    if (chunk.getDirtySections() == 0)
+        dirtyChunks.push_back(chunk.coord);
+    chunk.markSectionDirty(section);
+}
+
+void World::sectionEdited(Chunk& chunk, int section, glm::ivec3 localMin, glm::ivec3 localMax)
+{
+    markDirty(chunk, section);
+
+    const ChunkSection& blocks = chunk.getSection(section);
+    const glm::ivec3 origin = sectionOrigin(chunk.coord, section);
+    const int top = origin.y + localMax.y - 1;
+    const int bottom = origin.y + localMin.y;
+    Heightmap& heightmap = **heightmaps.find(columnOf(chunk.coord));
+    for (int z = localMin.z; z < localMax.z; z++)
+        for (int x = localMin.x; x < localMax.x; x++)
+        {
+            const int columnX = toLocal(origin.x + x);
+            const int columnZ = toLocal(origin.z + z);
+            const int height = heightmap.get(columnX, columnZ);
+
+            // Nothing above the written range is solid unless the column's top already was.
+            if (height > top)
+                continue;
+
+            int y = localMax.y - 1;
+            while (y >= localMin.y && blocks.getBlock(x, y, z) == BLOCK_AIR)
+                y--;
+
+            if (y >= localMin.y)
+                setHeight(heightmap, origin.x + x, origin.z + z, origin.y + y);
+            else if (height >= bottom)
+                setHeight(heightmap, origin.x + x, origin.z + z, scanDown(origin.x + x, bottom - 1, origin.z + z, heightmap));
+        }
+}
+
+void World::updateHeight(int x, int y, int z, BlockID block)
+{
+    Heightmap& heightmap = **heightmaps.find(columnOf(toChunkCoord(x, y, z)));
+    const int height = heightmap.get(toLocal(x), toLocal(z));
+    if (block != BLOCK_AIR)
+    {
+        if (y > height)
+            setHeight(heightmap, x, z, y);
+    }
+    else if (y == height)
+    {
+        setHeight(heightmap, x, z, scanDown(x, y - 1, z, heightmap));
+    }
+}
+
+void World::setHeight(Heightmap& heightmap, int x, int z, int height)
+{
+    const int before = heightmap.get(toLocal(x), toLocal(z));
+    if (height == before)
+        return;
+    heightmap.set(toLocal(x), toLocal(z), height);
+
+    // Blocks between the old and the new top switch between open sky and shade, so their sections
+    // are meshed again with new light. An empty column starts below its lowest chunk.
+    const int low = std::max(std::min(before, height), heightmap.getLowestChunk() * CHUNK_SIZE - 1);
+    const int high = std::max(before, height);
+    for (int y = low + 1; y <= high; y += SECTION_SIZE - toLocal(y) % SECTION_SIZE)
+    {
+        if (Chunk* chunk = getChunk(toChunkCoord(x, y, z)))
+            markDirty(*chunk, Chunk::sectionIndex(toLocal(x), toLocal(y), toLocal(z)));
+    }
+}
+
+int World::scanDown(int x, int y, int z, const Heightmap& heightmap) const
+{
+    const ChunkCoord start = toChunkCoord(x, y, z);
+    const int localX = toLocal(x);
+    const int localZ = toLocal(z);
+    for (int chunkY = start.y; chunkY >= heightmap.getLowestChunk(); chunkY--)
+    {
+        const Chunk* chunk = getChunk(ChunkCoord{ start.x, chunkY, start.z });
+        if (!chunk)
+            continue;
+
+        for (int localY = chunkY == start.y ? toLocal(y) : CHUNK_SIZE - 1; localY >= 0; localY--)
+        {
+            const ChunkSection& section = chunk->getSection(Chunk::sectionIndex(localX, localY, localZ));
+            if (section.isEmpty())
+            {
+                // Skip to the top of the section below.
+                localY -= localY % SECTION_SIZE;
+                continue;
+            }
+            if (section.getBlock(localX % SECTION_SIZE, localY % SECTION_SIZE, localZ % SECTION_SIZE) != BLOCK_AIR)
+                return chunkY * CHUNK_SIZE + localY;
+        }
+    }
+    return HEIGHT_NONE;
+}
+
+int World::getHeight(int x, int z) const
+{
+    const ChunkCoord column = toChunkCoord(x, 0, z);
+    const Heightmap* heightmap = getHeightmap(column.x, column.z);
+    return heightmap ? heightmap->get(toLocal(x), toLocal(z)) : HEIGHT_NONE;
+}
+
+const Heightmap* World::getHeightmap(int chunkX, int chunkZ) const
+{
+    const std::unique_ptr<Heightmap>* heightmap = heightmaps.find(ChunkCoord{ chunkX, 0, chunkZ });
+    return heightmap ? heightmap->get() : nullptr;
+}
+
+ChunkNeighborhood World::snapshotNeighborhood(ChunkCoord coord) const
+{
+    ChunkNeighborhood neighborhood;
+
+    // Heights of the padded columns, read from the 3x3 heightmaps around the chunk's column.
+    const Heightmap* columns[9];
+    for (int dz = -1; dz <= 1; dz++)
+        for (int dx = -1; dx <= 1; dx++)
+            columns[(dx + 1) + 3 * (dz + 1)] = getHeightmap(coord.x + dx, coord.z + dz);
+    for (int z = -1; z <= CHUNK_SIZE; z++)
+        for (int x = -1; x <= CHUNK_SIZE; x++)
+        {
+            const int dx = x < 0 ? -1 : x >= CHUNK_SIZE ? 1 : 0;
+            const int dz = z < 0 ? -1 : z >= CHUNK_SIZE ? 1 : 0;
+            const Heightmap* heightmap = columns[(dx + 1) + 3 * (dz + 1)];
+            neighborhood.surface[(x + 1) + (z + 1) * (CHUNK_SIZE + 2)] =
+                heightmap ? heightmap->get(x - dx * CHUNK_SIZE, z - dz * CHUNK_SIZE) : HEIGHT_NONE;
+        }
+
+    for (int dz = -1; dz <= 1; dz++)
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                ChunkSnapshot& snapshot = neighborhood.chunks[(dx + 1) + 3 * ((dy + 1) + 3 * (dz + 1))];
+                const ChunkCoord neighbor{ coord.x + dx, coord.y + dy, coord.z + dz };
+                if (const Chunk* chunk = getChunk(neighbor))
+                    snapshot = chunk->snapshot();
+                else
+                    snapshot.coord = neighbor;
+            }
+    return neighborhood;
+}
+
+std::size_t World::memoryUsage() const
+{
+    std::size_t total = 0;
+    chunks.forEach([&](ChunkCoord, const std::unique_ptr<Chunk>& chunk) {
+        total += sizeof(Chunk) + chunk->memoryUsage();
+    });
+    return total + heightmaps.size() * sizeof(Heightmap);
+}
@@ -0,0 +1,282 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <../include/glm/glm.hpp>
+
+#include "../Block/Block.h"
+#include "../Chunk/Chunk.h"
+#include "../ChunkMap/ChunkMap.h"
+#include "../ChunkNeighborhood/ChunkNeighborhood.h"
+#include "../Heightmap/Heightmap.h"
+#include "../VoxelStorage/VoxelStorage.h"
+
+// A loaded chunk with sections edited since the last call to World::takeDirtyChunks.
+struct DirtyChunk
+{
+    ChunkCoord coord;
+
+    // One bit per section index.
+    std::uint64_t sections;
+};
+
+// Block storage made of flat chunks, the default world storage backend.
+class World final : public VoxelStorage
+{
+public:
+    /**
+     * Returns the loaded chunk at the given chunk coordinate.
+     *
+     * @param coord The chunk coordinate.
+     * @return The chunk, or nullptr if it is not loaded.
+     */
+    Chunk* getChunk(ChunkCoord coord);
+    const Chunk* getChunk(ChunkCoord coord) const;
+
+    /**
+     * Returns the chunk at the given chunk coordinate, creating an empty one if it is not loaded.
+     *
+     * @param coord The chunk coordinate.
+     * @return The chunk.
+     */
+    Chunk& createChunk(ChunkCoord coord);
+
+    /**
+     * Unloads the chunk at the given chunk coordinate.
+     *
+     * @param coord The chunk coordinate.
+     */
+    void removeChunk(ChunkCoord coord);
+
+    /**
+     * Returns the block at the given world position.
+     *
+     * @param x World x-position.
+     * @param y World y-position.
+     * @param z World z-position.
+     * @return The ID of the block, or air if its chunk is not loaded.
+     */
+    BlockID getBlock(int x, int y, int z) const override;
+
+    /**
+     * Sets the block at the given world position, creating its chunk if needed.
+     *
+     * @param x World x-position.
+     * @param y World y-position.
+     * @param z World z-position.
+     * @param block The ID of the new block.
+     */
+    void setBlock(int x, int y, int z, BlockID block) override;
+
+    /**
+     * Sets every block in a box. Writes go straight into section storage, whole
+     * sections become uniform, and each touched section is marked dirty once.
+     *
+     * @param min Minimum world corner of the box (inclusive).
+     * @param max Maximum world corner of the box (exclusive).
+     * @param block The ID of the new block.
+     */
+    void fillBox(glm::ivec3 min, glm::ivec3 max, BlockID block);
+
+    /**
+     * Replaces one block type with another inside a box. Sections that do not contain
+     * the block being replaced are skipped without being copied or marked dirty.
+     *
+     * @param min Minimum world corner of the box (inclusive).
+     * @param max Maximum world corner of the box (exclusive).
+     * @param from The block to replace.
+     * @param to The block to replace it with.
+     */
+    void replaceBox(glm::ivec3 min, glm::ivec3 max, BlockID from, BlockID to);
+
+    /**
+     * Sets every block whose center lies within a sphere.
+     *
+     * @param center Center of the sphere in world space.
+     * @param radius Radius of the sphere in blocks.
+     * @param block The ID of the new block.
+     */
+    void fillSphere(glm::vec3 center, float radius, BlockID block);
+
+    /**
+     * Runs a batched write on one section, creating its chunk if needed. The section is
+     * copied first if a snapshot shares it, and marked dirty if the write changed it.
+     *
+     * @param coord The chunk coordinate.
+     * @param section The section index inside the chunk.
+     * @param write Called with the section; returns true if it changed any block.
+     */
+    template <typename Fn>
+    void editSection(ChunkCoord coord, int section, Fn&& write)
+    {
+        Chunk& chunk = createChunk(coord);
+        if (write(chunk.mutableSection(section)))
+            sectionEdited(chunk, section, glm::ivec3(0), glm::ivec3(SECTION_SIZE));
+    }
+
+    /**
+     * Returns the chunks edited since the last call and clears their dirty flags, so
+     * meshing and lighting run once per edited section however many blocks changed.
+     *
+     * @return The dirty chunks and their dirty sections, in the order they were first edited.
+     */
+    std::vector<DirtyChunk> takeDirtyChunks();
+
+    /**
+     * Returns the chunks unloaded since the last call, so meshes can be dropped and neighbors
+     * remeshed without scanning every chunk. A chunk may have been loaded again since.
+     *
+     * @return The unloaded chunks, in the order they were unloaded.
+     */
+    std::vector<ChunkCoord> takeUnloadedChunks();
+
+    /**
+     * Returns the height of a column in O(1).
+     *
+     * @param x World x-position.
+     * @param z World z-position.
+     * @return The world y-position of the highest non-air block in the loaded chunks, or HEIGHT_NONE.
+     */
+    int getHeight(int x, int z) const;
+
+    /**
+     * Returns the heightmap of a chunk column, kept up to date by every edit made through the world.
+     *
+     * @param chunkX Chunk x-position of the column.
+     * @param chunkZ Chunk z-position of the column.
+     * @return The heightmap, or nullptr if no chunk of the column is loaded.
+     */
+    const Heightmap* getHeightmap(int chunkX, int chunkZ) const;
+
+    /**
+     * Snapshots a chunk together with its 26 neighbors in O(1) per chunk, for use on worker threads.
+     * Must be called from the thread that edits the world.
+     *
+     * @param coord The chunk coordinate of the center chunk.
+     * @return The neighborhood; unloaded chunks read as air.
+     */
+    ChunkNeighborhood snapshotNeighborhood(ChunkCoord coord) const;
+
+    // Returns the number of loaded chunks.
+    std::size_t getChunkCount() const { return chunks.size(); }
+
+    /**
+     * Calls a function with the coordinate of every loaded chunk. The function must not load or unload chunks.
+     *
+     * @param fn Called as fn(ChunkCoord).
+     */
+    template <typename Fn>
+    void forEachChunk(Fn&& fn) const
+    {
+        chunks.forEach([&](ChunkCoord coord, const std::unique_ptr<Chunk>&) { fn(coord); });
+    }
+
+    // Returns the approximate number of heap bytes used by loaded chunks.
+    std::size_t memoryUsage() const override;
+
+    // Returns the chunk coordinate containing the given world position.
+    static ChunkCoord toChunkCoord(int x, int y, int z)
+    {
+        return ChunkCoord{ floorDiv(x), floorDiv(y), floorDiv(z) };
+    }
+
+    // Returns the position of a world coordinate inside its chunk.
+    static int toLocal(int v)
+    {
+        return v - floorDiv(v) * CHUNK_SIZE;
+    }
+
+private:
+    // Loaded chunks keyed by chunk coordinate.
+    ChunkMap<std::unique_ptr<Chunk>> chunks;
+
+    // Heightmaps of chunk columns with at least one loaded chunk, keyed by { chunkX, 0, chunkZ }.
+    ChunkMap<std::unique_ptr<Heightmap>> heightmaps;
+
+    // Chunks unloaded since the last call to takeUnloadedChunks.
+    std::vector<ChunkCoord> unloadedChunks;
+
+    // Chunks whose dirty flags went from clear to set, possibly including unloaded ones.
+    std::vector<ChunkCoord> dirtyChunks;
+
+    // Flags a section dirty and queues its chunk the first time one of its sections is flagged.
+    void markDirty(Chunk& chunk, int section);
+
+    /**
+     * Marks a section dirty after a batched write and updates the heights of the columns it covered.
+     *
+     * @param chunk The chunk containing the section.
+     * @param section The section index.
+     * @param localMin Minimum section-local corner of the written box (inclusive).
+     * @param localMax Maximum section-local corner of the written box (exclusive).
+     */
+    void sectionEdited(Chunk& chunk, int section, glm::ivec3 localMin, glm::ivec3 localMax);
+
+    /**
+     * Updates a column's height after one block changed: O(1) unless the top block was removed.
+     *
+     * @param x World x-position.
+     * @param y World y-position of the changed block.
+     * @param z World z-position.
+     * @param block The block's new ID.
+     */
+    void updateHeight(int x, int y, int z, BlockID block);
+
+    /**
+     * Sets a column's height and marks the sections whose blocks gained or lost open sky.
+     *
+     * @param heightmap The heightmap of the column.
+     * @param x World x-position.
+     * @param z World z-position.
+     * @param height The world y-position of the highest non-air block, or HEIGHT_NONE.
+     */
+    void setHeight(Heightmap& heightmap, int x, int z, int height);
+
+    /**
+     * Finds the highest non-air block at or below a position, skipping unloaded chunks and empty sections.
+     *
+     * @param x World x-position.
+     * @param y World y-position to start from.
+     * @param z World z-position.
+     * @param heightmap The heightmap of the column, which bounds the scan.
+     * @return The world y-position of the block, or HEIGHT_NONE.
+     */
+    int scanDown(int x, int y, int z, const Heightmap& heightmap) const;
+
+    // Returns the world position of a section's minimum corner.
+    static glm::ivec3 sectionOrigin(ChunkCoord coord, int section)
+    {
+        return glm::ivec3(coord.x, coord.y, coord.z) * CHUNK_SIZE + glm::ivec3(
+            section % SECTIONS_PER_AXIS, (section / SECTIONS_PER_AXIS) % SECTIONS_PER_AXIS, section / (SECTIONS_PER_AXIS * SECTIONS_PER_AXIS)
+        ) * SECTION_SIZE;
+    }
+
+    // Returns the key of the heightmap covering a chunk.
+    static ChunkCoord columnOf(ChunkCoord coord)
+    {
+        return ChunkCoord{ coord.x, 0, coord.z };
+    }
+
+    /**
+     * Calls fn(Chunk&, int section, glm::ivec3 localMin, glm::ivec3 localMax, glm::ivec3 sectionOrigin)
+     * for every section overlapping a box, with the overlap in section-local coordinates.
+     *
+     * @param min Minimum world corner of the box (inclusive).
+     * @param max Maximum world corner of the box (exclusive).
+     * @param create Whether to create chunks that are not loaded; unloaded chunks are skipped otherwise.
+     * @param fn The function to call; returns true if it changed the section.
+     */
+    template <typename Fn>
+    void forEachSectionInBox(glm::ivec3 min, glm::ivec3 max, bool create, Fn&& fn);
+
+    static int floorDiv(int v)
+    {
+        return (v >= 0 ? v : v - (CHUNK_SIZE - 1)) / CHUNK_SIZE;
+    }
+};
+
+#endif
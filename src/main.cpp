@@ -4,10 +4,18 @@
 #include "Shaders/Shader.h"
 #include "Core/Texture/Texture.h"
 #include "Core/Camera/Camera.h"
-#include "Core/VBO/VBO.h"
-#include "Core/VAO/VAO.h"
+#include "Core/Renderer/Renderer.h"
+#include "World/ChunkStreamer/ChunkStreamer.h"
+#include "World/FaceClassifier/FaceClassifier.h"
+#include "World/TerrainGenerator/TerrainGenerator.h"
+#include "World/World/World.h"
+
+#ifdef VOXEL_BENCHMARKS
+#include "Benchmarks/Benchmarks.h"
+#endif
 
 #include <iostream>
+#include <vector>
 
 #include <../include/glm/glm.hpp>
 #include <../include/glm/gtc/matrix_transform.hpp>
@@ -19,6 +27,10 @@ const unsigned int sWIDTH = 800;
 const unsigned int sHEIGHT = 600;
 const unsigned int FOV = 60;
 const char* TEXTURE_ATLAS = ".\\public\\textures\\texture_atlas.png";
+const float RENDER_DISTANCE = (float)(STREAM_DEFAULT_HORIZONTAL_RADIUS * CHUNK_SIZE);
+// Faces stores 4 bytes per face instead of merged quads of vertices, for machines short on GPU memory,
+// and SurfaceNets draws the terrain smooth instead of as cubes
+const ChunkMeshFormat CHUNK_MESH_FORMAT = ChunkMeshFormat::Vertices;
 
 // Computed variables
 const float ASPECT_RATIO = (float)sWIDTH / (float)sHEIGHT;
@@ -62,7 +74,33 @@ void scrollCallback(GLFWwindow* window, double xoffset, double yoffset)
     camera.handleMouseScrollZoom(window, xoffset, yoffset);
 }
 
+/* Checks every SIMD face classifier path against the scalar path, on the registered blocks and on a
+   larger table mixing opaque and transparent blocks beyond the built-in ones */
+static bool checkFaceClassifier()
+{
+    const BlockRegistry& registry = BlockRegistry::instance();
+    const FaceClassifier registered(registry.getOpacityTable(), registry.getBlockCount());
+
+    std::vector<std::uint8_t> opaque(4096);
+    for (std::size_t block = 1; block < opaque.size(); block++)
+        opaque[block] = block % 3 != 0;
+    const FaceClassifier extended(opaque.data(), opaque.size());
+
+    return registered.matchesScalar(8, 1) && extended.matchesScalar(8, 2);
+}
+
 int main() {
+    if (!checkFaceClassifier())
+    {
+        std::cout << "SIMD face classifier does not match the scalar path" << std::endl;
+        return 1;
+    }
+
+#ifdef VOXEL_BENCHMARKS
+    runBenchmarks();
+    return 0;
+#endif
+
     glfwInit();
     
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -103,120 +141,60 @@ int main() {
     texture.bind();
     texture.load(TEXTURE_ATLAS, GL_RGB);
 
-    auto [dirtX, dirtY] = texture.getTexelOffset(TextureType::Dirt);
-    auto [grassSX, grassSY] = texture.getTexelOffset(TextureType::GrassSide);
-    auto [grassTX, grassTY] = texture.getTexelOffset(TextureType::GrassTop);
-    
-    float vertices[] = {
-         // Position          // Texture   // Texture Offset
-         // Front face
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,  grassSX, grassSY,
-         0.5f, -0.5f, -0.5f,  1.0f, 0.0f,  grassSX, grassSY,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,  grassSX, grassSY,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,  grassSX, grassSY,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,  grassSX, grassSY,
-        -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,  grassSX, grassSY,
-
-        // Back face
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,  grassSX, grassSY,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,  grassSX, grassSY,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,  grassSX, grassSY,
-         0.5f,  0.5f,  0.5f,  1.0f, 1.0f,  grassSX, grassSY,
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,  grassSX, grassSY,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,  grassSX, grassSY,
-
-         // Left face
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,  grassSX, grassSY,
-        -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,  grassSX, grassSY,
-        -0.5f, -0.5f, -0.5f,  1.0f, 0.0f,  grassSX, grassSY,
-        -0.5f, -0.5f, -0.5f,  1.0f, 0.0f,  grassSX, grassSY,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,  grassSX, grassSY,
-        -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,  grassSX, grassSY,
-
-         // Right face
-         0.5f,  0.5f,  0.5f,  0.0f, 1.0f,  grassSX, grassSY,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,  grassSX, grassSY,
-         0.5f, -0.5f, -0.5f,  1.0f, 0.0f,  grassSX, grassSY,
-         0.5f, -0.5f, -0.5f,  1.0f, 0.0f,  grassSX, grassSY,
-         0.5f, -0.5f,  0.5f,  0.0f, 0.0f,  grassSX, grassSY,
-         0.5f,  0.5f,  0.5f,  0.0f, 1.0f,  grassSX, grassSY,
-
-         // Bottom face
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,  dirtX, dirtY,
-         0.5f, -0.5f, -0.5f,  1.0f, 1.0f,  dirtX, dirtY,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,  dirtX, dirtY,
-         0.5f, -0.5f,  0.5f,  1.0f, 0.0f,  dirtX, dirtY,
-        -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,  dirtX, dirtY,
-        -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,  dirtX, dirtY,
-
-         // Top face
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,  grassTX, grassTY,
-         0.5f,  0.5f, -0.5f,  1.0f, 1.0f,  grassTX, grassTY,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,  grassTX, grassTY,
-         0.5f,  0.5f,  0.5f,  1.0f, 0.0f,  grassTX, grassTY,
-        -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,  grassTX, grassTY,
-        -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,  grassTX, grassTY,
-    };
-
-    /* Create vertex array object and all associated configurations */
-    VAO CubeVAO;
-    VBO CubeVBO(vertices, sizeof(vertices));
-
-    // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Texture Coordinates
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Texture Offset
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(5 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
     /* Create shader */
-    Shader shader(".\\public\\shaders\\vertex.glsl", ".\\public\\shaders\\fragment.glsl");
+    const char* vertexShader = ".\\public\\shaders\\vertex.glsl";
+    const char* fragmentShader = ".\\public\\shaders\\fragment.glsl";
+    if (CHUNK_MESH_FORMAT == ChunkMeshFormat::Faces)
+    {
+        vertexShader = ".\\public\\shaders\\face_vertex.glsl";
+    }
+    else if (CHUNK_MESH_FORMAT == ChunkMeshFormat::SurfaceNets)
+    {
+        vertexShader = ".\\public\\shaders\\surface_vertex.glsl";
+        fragmentShader = ".\\public\\shaders\\surface_fragment.glsl";
+    }
+    Shader shader(vertexShader, fragmentShader);
     shader.use();
     shader.setInt("texture", 0);
-    shader.setFloat("atlasHeight", 1024.0);
+    shader.setFloat("atlasHeight", (float)texture.height);
     shader.setFloat("tileSize", (float)texture.TILE_SIZE);
+    shader.setInt("tilesPerRow", (int)(texture.width / texture.TILE_SIZE));
 
-    while (!glfwWindowShouldClose(window))
+    // Scoped so the renderer's buffers are deleted while the context still exists
     {
-        float currentFrame = (float)glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
-        processInput(window);
-
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        CubeVAO.bind();
-
-        for (int i = 0; i < 6; i++) {
-
-            glm::mat4 model = glm::mat4(1.0f);
-            glm::mat4 view = glm::mat4(1.0f);
-            glm::mat4 projection = glm::mat4(1.0f);
+        /* Create the world, streamed in cubic chunks around the camera */
+        World world;
+        TerrainGenerator generator;
+        ChunkStreamer streamer(world, generator);
+        Renderer renderer(CHUNK_MESH_FORMAT);
+
+        // Start just above the terrain
+        camera.cameraPos.y = (float)generator.getSurfaceHeight(0, 3) + 4.0f;
+
+        while (!glfwWindowShouldClose(window))
+        {
+            float currentFrame = (float)glfwGetTime();
+            deltaTime = currentFrame - lastFrame;
+            lastFrame = currentFrame;
+            processInput(window);
+            streamer.update(camera.cameraPos);
+            renderer.update(world);
+
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            glm::mat4 view = camera.lookAt();
+            glm::mat4 projection = glm::perspective(glm::radians(camera.fov), ASPECT_RATIO, 0.1f, RENDER_DISTANCE);
 
-            view = camera.lookAt();
-
-            projection = glm::perspective(glm::radians(camera.fov), ASPECT_RATIO, 0.1f, 100.0f);
-
-            shader.setMat4("model", model);
             shader.setMat4("view", view);
             shader.setMat4("projection", projection);
-            glDrawArrays(GL_TRIANGLES, i * 6, 6);
-        }
+            renderer.draw(shader);
 
-
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
-    CubeVAO.remove();
-    CubeVBO.remove();
-
     glfwTerminate();
     return 0;
 }
\ No newline at end of file